@@ -0,0 +1,284 @@
+// ホットリロード可能な不変設定スナップショット
+// example.cpp の g_configs はグローバルな std::map<std::string, Config> で、
+// 実行中に書き換えると読み取り側とデータ競合になる。
+// ここでは設定一式を「不変スナップショット」として作り、shared_ptr を
+// アトミックに差し替えて公開する（RCU 風）。
+//
+//   - 書き込み側: ファイルから新しいスナップショットを組み立て、
+//                 atomic_store で一度に差し替える
+//   - 読み取り側: スレッドごとの Reader がスナップショットをキャッシュし、
+//                 世代番号が変わっていなければ共有変数への書き込みなしで返す
+//   - 検索: ソート済みの連続配列に対する二分探索（std::map より局所性が高い）
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 1. 設定と不変スナップショット
+// ============================================================================
+
+struct Config {
+  int max_connections = 100;
+  int timeout_seconds = 30;
+  bool debug_mode = false;
+};
+
+class ConfigSnapshot {
+ public:
+  ConfigSnapshot(uint64_t generation,
+                 std::vector<std::pair<std::string, Config>> entries)
+      : generation_(generation), entries_(std::move(entries)) {
+    std::stable_sort(entries_.begin(), entries_.end(),
+                     [](const auto& a, const auto& b) {
+                       return a.first < b.first;
+                     });
+    // 同じ名前が重複した場合は後勝ちにする
+    auto last = std::unique(entries_.rbegin(), entries_.rend(),
+                            [](const auto& a, const auto& b) {
+                              return a.first == b.first;
+                            });
+    entries_.erase(entries_.begin(), last.base());
+  }
+
+  // 見つからなければ nullptr（スナップショットが生きている間は有効）
+  const Config* find(std::string_view name) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), name,
+                               [](const auto& entry, std::string_view key) {
+                                 return entry.first < key;
+                               });
+    if (it != entries_.end() && it->first == name) {
+      return &it->second;
+    }
+    return nullptr;
+  }
+
+  uint64_t generation() const { return generation_; }
+  size_t size() const { return entries_.size(); }
+
+ private:
+  uint64_t generation_;
+  std::vector<std::pair<std::string, Config>> entries_;
+};
+
+// ============================================================================
+// 2. ConfigStore
+// ============================================================================
+
+class ConfigStore {
+ public:
+  using SnapshotPtr = std::shared_ptr<const ConfigSnapshot>;
+
+  ConfigStore()
+      : current_(std::make_shared<const ConfigSnapshot>(
+            0, std::vector<std::pair<std::string, Config>>{})) {}
+
+  // 新しいスナップショットを公開する（書き込み側同士は直列化する）
+  void publish(std::vector<std::pair<std::string, Config>> entries) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    uint64_t generation = generation_.load(std::memory_order_relaxed) + 1;
+    auto next = std::make_shared<const ConfigSnapshot>(generation,
+                                                       std::move(entries));
+    std::atomic_store_explicit(&current_, SnapshotPtr(std::move(next)),
+                               std::memory_order_release);
+    generation_.store(generation, std::memory_order_release);
+  }
+
+  // ファイルを読み込んで差し替える。失敗した場合は現在の設定を維持する。
+  // 形式: 1行に "name max_connections timeout_seconds debug(0/1)"、# はコメント
+  bool reload_from_file(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+      std::cout << "  [エラー] 設定ファイルを開けません: " << path << std::endl;
+      return false;
+    }
+
+    std::vector<std::pair<std::string, Config>> entries;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+      ++line_number;
+      if (auto hash = line.find('#'); hash != std::string::npos) {
+        line.erase(hash);
+      }
+      std::istringstream fields(line);
+      std::string name;
+      if (!(fields >> name)) {
+        continue;  // 空行
+      }
+      Config config;
+      int debug = 0;
+      if (!(fields >> config.max_connections >> config.timeout_seconds >>
+            debug)) {
+        std::cout << "  [エラー] " << path.filename() << ":" << line_number
+                  << " の形式が不正です" << std::endl;
+        return false;
+      }
+      config.debug_mode = debug != 0;
+      entries.emplace_back(std::move(name), config);
+    }
+
+    publish(std::move(entries));
+    return true;
+  }
+
+  // 現在のスナップショットを取得する（参照カウントの更新を伴う）
+  SnapshotPtr snapshot() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+  }
+
+  uint64_t generation() const {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  // リクエスト処理スレッドごとに1つ持つ読み取りハンドル。
+  // 世代番号が変わらない限り、手元のスナップショットをそのまま返す
+  // （共有キャッシュラインへの書き込みもロックも発生しない）。
+  // 返した参照は同じ Reader で次に get() を呼ぶまで有効。
+  class Reader {
+   public:
+    explicit Reader(const ConfigStore& store)
+        : store_(store), cached_(store.snapshot()) {}
+
+    const ConfigSnapshot& get() {
+      if (store_.generation() != cached_->generation()) {
+        cached_ = store_.snapshot();  // リロード後の初回のみ
+      }
+      return *cached_;
+    }
+
+   private:
+    const ConfigStore& store_;
+    SnapshotPtr cached_;
+  };
+
+ private:
+  SnapshotPtr current_;
+  std::atomic<uint64_t> generation_{0};
+  std::mutex write_mutex_;
+};
+
+// ============================================================================
+// 3. 基本的な使い方
+// ============================================================================
+
+std::filesystem::path write_config_file(const std::string& contents) {
+  auto path = std::filesystem::temp_directory_path() / "config_store_demo.txt";
+  std::ofstream(path) << contents;
+  return path;
+}
+
+void basic_example() {
+  std::cout << "=== 基本的な使い方 ===" << std::endl;
+
+  ConfigStore store;
+  auto path = write_config_file(
+      "# name  max_conn  timeout  debug\n"
+      "server1  100  30  0\n"
+      "server2  200  60  1\n");
+  store.reload_from_file(path);
+
+  ConfigStore::Reader reader(store);
+  if (const Config* config = reader.get().find("server2"); config) {
+    std::cout << "server2: max_connections=" << config->max_connections
+              << ", timeout=" << config->timeout_seconds << "s, debug="
+              << (config->debug_mode ? "ON" : "OFF") << std::endl;
+  }
+
+  // 不正なファイルでは差し替えない
+  write_config_file("server1 abc\n");
+  store.reload_from_file(path);
+  std::cout << "不正なリロード後の世代: " << store.generation()
+            << " (エントリ数: " << reader.get().size() << ")" << std::endl;
+
+  std::filesystem::remove(path);
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 4. 読み取り中のホットリロード
+// ============================================================================
+
+void hot_reload_example() {
+  std::cout << "=== 読み取り中のホットリロード ===" << std::endl;
+
+  ConfigStore store;
+  std::atomic<bool> stop{false};
+  std::atomic<int64_t> lookups{0};
+  std::atomic<int64_t> inconsistent{0};
+
+  // 各世代では全サーバの max_connections が同じ値になるように書き込む
+  auto make_entries = [](int value) {
+    std::vector<std::pair<std::string, Config>> entries;
+    for (int i = 0; i < 64; ++i) {
+      entries.emplace_back("server" + std::to_string(i),
+                           Config{value, value / 10, false});
+    }
+    return entries;
+  };
+  store.publish(make_entries(100));
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.emplace_back([&, r] {
+      ConfigStore::Reader reader(store);
+      int64_t local = 0;
+      std::string a = "server" + std::to_string(r);
+      std::string b = "server" + std::to_string(63 - r);
+      while (!stop.load(std::memory_order_relaxed)) {
+        const ConfigSnapshot& snapshot = reader.get();
+        const Config* first = snapshot.find(a);
+        const Config* second = snapshot.find(b);
+        // 同じスナップショット内の値は必ず一貫している
+        if (!first || !second ||
+            first->max_connections != second->max_connections) {
+          inconsistent.fetch_add(1);
+        }
+        ++local;
+      }
+      lookups.fetch_add(local);
+    });
+  }
+
+  for (int value = 200; value <= 1000; value += 100) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    store.publish(make_entries(value));
+  }
+  stop = true;
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  std::cout << "リロード回数: " << store.generation() - 1 << std::endl;
+  std::cout << "検索回数: " << lookups << std::endl;
+  std::cout << "不整合: " << inconsistent << " (期待値: 0)" << std::endl;
+  std::cout << "最新の server0.max_connections: "
+            << store.snapshot()->find("server0")->max_connections << std::endl;
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "不変設定スナップショットのサンプル\n" << std::endl;
+
+  basic_example();
+  hot_reload_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,87 @@
+// 計算結果のキャッシュ（大きな n 対応版）
+// example.cpp の cache_example() は指数時間の再帰 fibonacci(int) の結果を
+// g_fibonacci_cache に入れているため、n = 40 程度で実用にならず、
+// n = 47 以降は int が桁あふれする。
+// ここでは libs/common の高速倍加法（O(log n) 回の乗算）と任意精度整数を
+// 使い、同じ if 初期化式のキャッシュパターンで大きな n を扱う。
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "common/big_uint.h"
+#include "common/fibonacci.h"
+
+using common::BigUint;
+
+// ============================================================================
+// 1. BigUint を値に持つキャッシュ
+// ============================================================================
+
+std::unordered_map<uint64_t, BigUint> g_fibonacci_cache;
+
+// 長い数は先頭と末尾だけ表示する
+std::string abbreviate(const std::string& digits) {
+  if (digits.size() <= 40) {
+    return digits;
+  }
+  return digits.substr(0, 15) + "..." + digits.substr(digits.size() - 15) +
+         " (" + std::to_string(digits.size()) + " 桁)";
+}
+
+const BigUint& cached_fibonacci(uint64_t n) {
+  if (auto it = g_fibonacci_cache.find(n); it != g_fibonacci_cache.end()) {
+    std::cout << "Cache hit! ";
+    return it->second;
+  }
+  std::cout << "Cache miss! ";
+  auto [it, inserted] = g_fibonacci_cache.emplace(n, common::fibonacci(n));
+  return it->second;
+}
+
+void cache_example() {
+  std::cout << "=== 大きな n のキャッシュ ===" << std::endl;
+
+  for (uint64_t n : {10ull, 93ull, 94ull, 1000ull, 10000ull, 1000ull}) {
+    auto begin = std::chrono::steady_clock::now();
+    const BigUint& value = cached_fibonacci(n);
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    std::cout << "fibonacci(" << n << ") = " << abbreviate(value.to_string())
+              << " [" << elapsed.count() << " us]" << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. 小さな n はコンパイル時に計算できる
+// ============================================================================
+
+void constexpr_example() {
+  std::cout << "=== constexpr 版 ===" << std::endl;
+
+  constexpr uint64_t kFib90 = common::fibonacci_u64(90);
+  static_assert(kFib90 == 2880067194370816120ull);
+  std::cout << "fibonacci_u64(90) = " << kFib90 << " (コンパイル時に計算)"
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "高速倍加法によるフィボナッチキャッシュのサンプル\n"
+            << std::endl;
+
+  cache_example();
+  constexpr_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
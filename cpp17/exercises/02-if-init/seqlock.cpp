@@ -0,0 +1,260 @@
+// 読み取り最適化版 SharedResource（シーケンスロック）
+// example.cpp の SharedResource は std::mutex で int を守っているため、
+// 読み取り同士も直列化される。読み取りが圧倒的に多い設定値・状態値では、
+// シーケンスロック（seqlock）を使うと読み取り側は共有キャッシュラインへ
+// 一切書き込まずに済む。
+//
+// 仕組み:
+//   - 書き込み側: シーケンス番号を奇数にする → データを書く → 偶数に戻す
+//   - 読み取り側: 番号を読む → データをコピー → 番号を読み直し、
+//                 奇数または変化していたらリトライ
+//
+// ベンチマーク: 1〜64 スレッドで読み取り:書き込み = 10,000:1 の負荷をかけ、
+// std::mutex / std::shared_mutex / seqlock を比較する。
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// ============================================================================
+// 1. 従来の SharedResource（std::mutex / std::shared_mutex）
+// ============================================================================
+
+template <typename T>
+class MutexResource {
+ public:
+  void update(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_ = value;
+  }
+  T get() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return data_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  T data_{};
+};
+
+template <typename T>
+class SharedMutexResource {
+ public:
+  void update(const T& value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    data_ = value;
+  }
+  T get() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);  // 読み取り同士は並行
+    return data_;
+  }
+
+ private:
+  mutable std::shared_mutex mutex_;
+  T data_{};
+};
+
+// ============================================================================
+// 2. SeqlockResource
+// ============================================================================
+
+// ペイロードは trivially copyable に限定する（バイト単位でコピーするため）。
+// データ競合を未定義動作にしないよう、ペイロードは relaxed な atomic ワード
+// の配列として保持し、フェンスで順序付けする。
+template <typename T>
+class SeqlockResource {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SeqlockResource requires a trivially copyable payload");
+
+ public:
+  SeqlockResource() { store_words(T{}); }
+
+  // 書き込み側同士は mutex で直列化する（書き込みは稀な前提）
+  void update(const T& value) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);  // 奇数: 書き込み中
+    std::atomic_thread_fence(std::memory_order_release);
+    store_words(value);
+    seq_.store(seq + 2, std::memory_order_release);  // 偶数: 完了
+  }
+
+  // 読み取り側はどの共有変数にも書き込まない
+  T get() const {
+    std::array<uint64_t, kWords> buffer;
+    uint64_t before;
+    uint64_t after;
+    do {
+      before = seq_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < kWords; ++i) {
+        buffer[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = seq_.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+
+    T value;
+    std::memcpy(&value, buffer.data(), sizeof(T));
+    return value;
+  }
+
+ private:
+  static constexpr size_t kWords = (sizeof(T) + 7) / 8;
+
+  void store_words(const T& value) {
+    std::array<uint64_t, kWords> buffer{};
+    std::memcpy(buffer.data(), &value, sizeof(T));
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(buffer[i], std::memory_order_relaxed);
+    }
+  }
+
+  // シーケンス番号とデータを同じキャッシュラインに置き、
+  // 書き込み用の mutex とは別ラインに分ける
+  alignas(64) std::atomic<uint64_t> seq_{0};
+  std::array<std::atomic<uint64_t>, kWords> words_;
+  alignas(64) std::mutex write_mutex_;
+};
+
+// ============================================================================
+// 3. 動作確認（書き込み途中の値が見えないこと）
+// ============================================================================
+
+struct ServerState {
+  int64_t version;
+  int32_t max_connections;
+  int32_t timeout_seconds;  // 常に max_connections / 10 を保つ
+};
+
+void consistency_example() {
+  std::cout << "=== 一貫性の確認 ===" << std::endl;
+
+  SeqlockResource<ServerState> resource;
+  std::atomic<bool> stop{false};
+  std::atomic<int64_t> torn_reads{0};
+
+  std::thread writer([&] {
+    for (int32_t i = 1; i <= 200000; ++i) {
+      resource.update({i, i * 10, i});
+    }
+    stop = true;
+  });
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 2; ++r) {
+    readers.emplace_back([&] {
+      while (!stop.load(std::memory_order_relaxed)) {
+        ServerState s = resource.get();
+        if (s.max_connections != s.timeout_seconds * 10 ||
+            s.version != s.timeout_seconds) {
+          torn_reads.fetch_add(1);
+        }
+      }
+    });
+  }
+
+  writer.join();
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  std::cout << "不整合な読み取り: " << torn_reads << " (期待値: 0)"
+            << std::endl;
+  std::cout << "最終値: version=" << resource.get().version << std::endl;
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 4. 読み取りスケーリングのベンチマーク
+// ============================================================================
+
+constexpr int kReadsPerWrite = 10000;
+constexpr auto kBenchDuration = std::chrono::milliseconds(100);
+
+// 読み取り結果を最適化で消されないように集約する
+std::atomic<int64_t> g_sink{0};
+
+// 全スレッドが kReadsPerWrite 回に1回だけ書き込みを行い、
+// 一定時間内の総読み取り数を返す
+template <typename Resource>
+double measure_reads_per_sec(int thread_count) {
+  Resource resource;
+  std::atomic<bool> start{false};
+  std::atomic<bool> stop{false};
+  std::atomic<int64_t> total_reads{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&, t] {
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      int64_t reads = 0;
+      int64_t sink = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < kReadsPerWrite; ++i) {
+          sink += resource.get().version;
+        }
+        reads += kReadsPerWrite;
+        resource.update({reads, t, t});
+      }
+      total_reads.fetch_add(reads);
+      g_sink.fetch_add(sink, std::memory_order_relaxed);
+    });
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(kBenchDuration);
+  stop = true;
+  for (auto& t : threads) {
+    t.join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return static_cast<double>(total_reads.load()) / elapsed.count();
+}
+
+void read_scaling_benchmark() {
+  std::cout << "=== 読み取りスケーリング (reads:writes = " << kReadsPerWrite
+            << ":1) ===" << std::endl;
+  std::cout << "ハードウェアスレッド数: " << std::thread::hardware_concurrency()
+            << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "mutex"
+            << std::setw(16) << "shared_mutex" << std::setw(16) << "seqlock"
+            << "  (M reads/s)" << std::endl;
+
+  for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+    double m = measure_reads_per_sec<MutexResource<ServerState>>(threads);
+    double s = measure_reads_per_sec<SharedMutexResource<ServerState>>(threads);
+    double q = measure_reads_per_sec<SeqlockResource<ServerState>>(threads);
+    std::cout << std::fixed << std::setprecision(1) << std::setw(8) << threads
+              << std::setw(16) << m / 1e6 << std::setw(16) << s / 1e6
+              << std::setw(16) << q / 1e6 << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "シーケンスロックのサンプル\n" << std::endl;
+
+  consistency_example();
+  read_scaling_benchmark();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
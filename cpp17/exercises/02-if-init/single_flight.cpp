@@ -0,0 +1,199 @@
+// シングルフライト（リクエスト合流）キャッシュ
+// 演習 1.2.1 のキャッシュパターンを複数スレッドから同時に使うと、
+// 同じキーのキャッシュミスが重なったときに expensive_calculation が
+// スレッドの数だけ実行されてしまう（thundering herd）。
+// ここでは最初の呼び出し元だけが計算し、同じキーを待つ他のスレッドは
+// std::shared_future で同じ結果（または例外）を受け取る。
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 1. SingleFlightCache
+// ============================================================================
+
+template <typename Key, typename Value>
+class SingleFlightCache {
+ public:
+  // キャッシュにあればそれを返し、なければ compute(key) で計算する。
+  // 同じキーの計算が進行中なら、その完了を待って同じ結果を返す。
+  // compute が例外を投げた場合は待機中の全員に同じ例外が伝播し、
+  // キーはキャッシュにも進行中リストにも残らない（次の呼び出しで再計算）。
+  template <typename Compute>
+  Value get_or_compute(const Key& key, Compute&& compute) {
+    std::promise<Value> promise;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (auto it = cache_.find(key); it != cache_.end()) {
+        return it->second;
+      }
+      if (auto it = in_flight_.find(key); it != in_flight_.end()) {
+        std::shared_future<Value> pending = it->second;
+        lock.unlock();
+        return pending.get();  // 失敗時は get() が例外を再送出する
+      }
+      in_flight_.emplace(key, promise.get_future().share());
+    }
+
+    // ロックの外で計算する（他のキーの処理を止めない）
+    try {
+      Value value = std::invoke(std::forward<Compute>(compute), key);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.emplace(key, value);
+        in_flight_.erase(key);
+      }
+      promise.set_value(value);
+      return value;
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_.erase(key);  // キーを汚染しない
+      }
+      promise.set_exception(std::current_exception());
+      throw;
+    }
+  }
+
+  // キャッシュを破棄する（進行中の計算はそのまま完了させる）
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, Value> cache_;
+  std::unordered_map<Key, std::shared_future<Value>> in_flight_;
+};
+
+// ============================================================================
+// 2. 重い計算のシミュレーション
+// ============================================================================
+
+std::atomic<int> g_calculation_count{0};
+
+int expensive_calculation(int x) {
+  g_calculation_count.fetch_add(1, std::memory_order_relaxed);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  return x * x;
+}
+
+// ============================================================================
+// 3. 同時キャッシュミスの合流
+// ============================================================================
+
+void coalescing_example() {
+  std::cout << "=== 同時キャッシュミスの合流 ===" << std::endl;
+
+  SingleFlightCache<int, int> cache;
+  constexpr int kThreads = 16;
+  std::vector<int> results(kThreads);
+  std::vector<std::thread> threads;
+
+  g_calculation_count = 0;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&cache, &results, i] {
+      results[static_cast<size_t>(i)] =
+          cache.get_or_compute(5, expensive_calculation);
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  std::cout << kThreads << " スレッドが同じキーを要求" << std::endl;
+  std::cout << "  計算回数: " << g_calculation_count << " (期待値: 1)"
+            << std::endl;
+  std::cout << "  結果: " << results.front() << std::endl;
+
+  // キャッシュをフラッシュした直後も同じく1回だけ計算される
+  cache.clear();
+  threads.clear();
+  g_calculation_count = 0;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back(
+        [&cache] { cache.get_or_compute(5, expensive_calculation); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  std::cout << "フラッシュ後の計算回数: " << g_calculation_count
+            << " (期待値: 1)" << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 4. 失敗の伝播とキーの非汚染
+// ============================================================================
+
+void failure_example() {
+  std::cout << "=== 失敗の伝播 ===" << std::endl;
+
+  SingleFlightCache<int, int> cache;
+  std::atomic<int> attempts{0};
+
+  auto flaky = [&attempts](int x) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    if (attempts.fetch_add(1) == 0) {
+      throw std::runtime_error("backend unavailable");
+    }
+    return x * x;
+  };
+
+  constexpr int kThreads = 8;
+  std::atomic<int> failures{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&] {
+      try {
+        cache.get_or_compute(7, flaky);
+      } catch (const std::runtime_error&) {
+        failures.fetch_add(1);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // 合流したスレッドは全員同じ例外を受け取る（合流しなかった分は再計算に成功）
+  std::cout << "失敗したスレッド数: " << failures << " / " << kThreads
+            << std::endl;
+
+  // 失敗したキーはキャッシュされていないので、再計算できる
+  int value = cache.get_or_compute(7, flaky);
+  std::cout << "再試行の結果: " << value << " (試行回数: " << attempts << ")"
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "シングルフライトキャッシュのサンプル\n" << std::endl;
+
+  coalescing_example();
+  failure_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,504 @@
+// 一様グリッドによるブロードフェーズ（衝突候補ペアの列挙）
+// 演習の Point2D<T> を使い、10万個以上の動く物体から「近くにいるペア」を
+// 求める。総当たり O(n^2) の代わりに、空間を一様なセルに分割して
+// 同じセルに入った物体同士だけを調べる。
+//
+//   - 構築: 各物体の AABB が重なるセルを数え、計数ソートで
+//           セルごとに連続した配列（CSR 形式）に並べる
+//   - 重複除去: 2つの AABB の重なり領域の左下隅を含むセル（ホームセル）
+//               でだけペアを出力する
+//   - 差分更新: セルの範囲が変わらない移動は AABB の書き換えだけ。
+//               範囲が変わった物体は「dirty」として別扱いにし、
+//               走査時に一定数を超えていたら全体を再構築する
+//   - 並列化: セルの行をスレッドに分けて走査する
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 1. Point2D と AABB
+// ============================================================================
+
+template <typename T>
+struct Point2D {
+  T x;
+  T y;
+};
+
+template <typename T>
+Point2D(T, T) -> Point2D<T>;
+
+template <typename T>
+struct AABB {
+  Point2D<T> min;
+  Point2D<T> max;
+
+  static AABB around(Point2D<T> center, T radius) {
+    return {{center.x - radius, center.y - radius},
+            {center.x + radius, center.y + radius}};
+  }
+
+  bool overlaps(const AABB& other) const {
+    return min.x <= other.max.x && other.min.x <= max.x &&
+           min.y <= other.max.y && other.min.y <= max.y;
+  }
+};
+
+template <typename T>
+AABB(Point2D<T>, Point2D<T>) -> AABB<T>;
+
+// ============================================================================
+// 2. UniformGrid
+// ============================================================================
+
+template <typename T>
+class UniformGrid {
+ public:
+  using Pair = std::pair<uint32_t, uint32_t>;  // (小さい id, 大きい id)
+
+  UniformGrid(AABB<T> world, T cell_size)
+      : world_(world),
+        inv_cell_(T(1) / cell_size),
+        cols_(std::max(1, static_cast<int>(std::ceil(
+                              (world.max.x - world.min.x) * inv_cell_)))),
+        rows_(std::max(1, static_cast<int>(std::ceil(
+                              (world.max.y - world.min.y) * inv_cell_)))) {}
+
+  // 全物体を登録し直す（計数ソートで O(n + セル数)）
+  void build(std::vector<AABB<T>> boxes) {
+    boxes_ = std::move(boxes);
+    rebuild();
+  }
+
+  // 1物体の差分更新
+  void update(uint32_t id, const AABB<T>& box) {
+    boxes_[id] = box;
+    if (!dirty_flag_[id] && !(range_of(box) == ranges_[id])) {
+      dirty_flag_[id] = 1;
+      dirty_.push_back(id);
+    }
+  }
+
+  // 重なっている候補ペアを重複なしで列挙する。
+  // dirty な物体が多すぎる場合は、先に全体を再構築する（1フレームに最大1回）
+  std::vector<Pair> find_pairs(unsigned thread_count = 1) {
+    if (dirty_.size() > rebuild_threshold()) {
+      rebuild();
+    }
+    thread_count = std::max(1u, std::min<unsigned>(thread_count,
+                                                   static_cast<unsigned>(rows_)));
+    std::vector<std::vector<Pair>> partial(thread_count);
+
+    if (thread_count == 1) {
+      sweep_rows(0, rows_, partial[0]);
+    } else {
+      std::vector<std::thread> workers;
+      int rows_per_thread =
+          (rows_ + static_cast<int>(thread_count) - 1) /
+          static_cast<int>(thread_count);
+      for (unsigned t = 0; t < thread_count; ++t) {
+        int begin = static_cast<int>(t) * rows_per_thread;
+        int end = std::min(rows_, begin + rows_per_thread);
+        workers.emplace_back([this, begin, end, &out = partial[t]] {
+          sweep_rows(begin, end, out);
+        });
+      }
+      for (auto& w : workers) {
+        w.join();
+      }
+    }
+
+    std::vector<Pair> pairs;
+    size_t total = 0;
+    for (const auto& p : partial) {
+      total += p.size();
+    }
+    pairs.reserve(total);
+    for (const auto& p : partial) {
+      pairs.insert(pairs.end(), p.begin(), p.end());
+    }
+    sweep_dirty(pairs);
+    return pairs;
+  }
+
+  size_t dirty_count() const { return dirty_.size(); }
+  size_t rebuild_count() const { return rebuilds_; }
+  size_t cell_count() const { return static_cast<size_t>(cols_) * rows_; }
+
+ private:
+  struct CellRange {
+    int x0, y0, x1, y1;
+    bool operator==(const CellRange& o) const {
+      return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1;
+    }
+  };
+
+  size_t rebuild_threshold() const {
+    return std::max<size_t>(64, boxes_.size() / 64);
+  }
+
+  int clamp_x(T x) const {
+    int c = static_cast<int>(std::floor((x - world_.min.x) * inv_cell_));
+    return std::clamp(c, 0, cols_ - 1);
+  }
+  int clamp_y(T y) const {
+    int c = static_cast<int>(std::floor((y - world_.min.y) * inv_cell_));
+    return std::clamp(c, 0, rows_ - 1);
+  }
+
+  CellRange range_of(const AABB<T>& box) const {
+    return {clamp_x(box.min.x), clamp_y(box.min.y), clamp_x(box.max.x),
+            clamp_y(box.max.y)};
+  }
+
+  size_t cell_index(int cx, int cy) const {
+    return static_cast<size_t>(cy) * static_cast<size_t>(cols_) +
+           static_cast<size_t>(cx);
+  }
+
+  // a と b の重なり領域の左下隅が (cx, cy) に入っていれば true
+  bool is_home_cell(const AABB<T>& a, const AABB<T>& b, int cx, int cy) const {
+    return clamp_x(std::max(a.min.x, b.min.x)) == cx &&
+           clamp_y(std::max(a.min.y, b.min.y)) == cy;
+  }
+
+  void rebuild() {
+    size_t cells = cell_count();
+    ranges_.resize(boxes_.size());
+    cell_start_.assign(cells + 1, 0);
+
+    // 1パス目: セルごとの要素数を数える
+    for (size_t id = 0; id < boxes_.size(); ++id) {
+      CellRange r = range_of(boxes_[id]);
+      ranges_[id] = r;
+      for (int cy = r.y0; cy <= r.y1; ++cy) {
+        for (int cx = r.x0; cx <= r.x1; ++cx) {
+          ++cell_start_[cell_index(cx, cy) + 1];
+        }
+      }
+    }
+    // 累積和で各セルの開始位置を求める
+    for (size_t c = 0; c < cells; ++c) {
+      cell_start_[c + 1] += cell_start_[c];
+    }
+    // 2パス目: 書き込み
+    cell_items_.resize(cell_start_[cells]);
+    std::vector<uint32_t> cursor(cell_start_.begin(), cell_start_.end() - 1);
+    for (size_t id = 0; id < boxes_.size(); ++id) {
+      const CellRange& r = ranges_[id];
+      for (int cy = r.y0; cy <= r.y1; ++cy) {
+        for (int cx = r.x0; cx <= r.x1; ++cx) {
+          cell_items_[cursor[cell_index(cx, cy)]++] = static_cast<uint32_t>(id);
+        }
+      }
+    }
+
+    dirty_flag_.assign(boxes_.size(), 0);
+    dirty_.clear();
+    ++rebuilds_;
+  }
+
+  // 登録済み（dirty でない）物体同士のペア
+  void sweep_rows(int row_begin, int row_end, std::vector<Pair>& out) const {
+    for (int cy = row_begin; cy < row_end; ++cy) {
+      for (int cx = 0; cx < cols_; ++cx) {
+        size_t cell = cell_index(cx, cy);
+        uint32_t begin = cell_start_[cell];
+        uint32_t end = cell_start_[cell + 1];
+        for (uint32_t i = begin; i < end; ++i) {
+          uint32_t a = cell_items_[i];
+          if (dirty_flag_[a]) {
+            continue;
+          }
+          for (uint32_t j = i + 1; j < end; ++j) {
+            uint32_t b = cell_items_[j];
+            if (dirty_flag_[b] || !boxes_[a].overlaps(boxes_[b]) ||
+                !is_home_cell(boxes_[a], boxes_[b], cx, cy)) {
+              continue;
+            }
+            out.emplace_back(std::min(a, b), std::max(a, b));
+          }
+        }
+      }
+    }
+  }
+
+  // dirty な物体が関わるペア（現在の位置でセルを引き直す）
+  void sweep_dirty(std::vector<Pair>& out) const {
+    for (uint32_t d : dirty_) {
+      const AABB<T>& box = boxes_[d];
+      CellRange r = range_of(box);
+      for (int cy = r.y0; cy <= r.y1; ++cy) {
+        for (int cx = r.x0; cx <= r.x1; ++cx) {
+          size_t cell = cell_index(cx, cy);
+          for (uint32_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+            uint32_t e = cell_items_[i];
+            if (dirty_flag_[e] || !box.overlaps(boxes_[e]) ||
+                !is_home_cell(box, boxes_[e], cx, cy)) {
+              continue;
+            }
+            out.emplace_back(std::min(d, e), std::max(d, e));
+          }
+        }
+      }
+    }
+    // dirty 同士は数が少ないので総当たり
+    for (size_t i = 0; i < dirty_.size(); ++i) {
+      for (size_t j = i + 1; j < dirty_.size(); ++j) {
+        uint32_t a = dirty_[i];
+        uint32_t b = dirty_[j];
+        if (boxes_[a].overlaps(boxes_[b])) {
+          out.emplace_back(std::min(a, b), std::max(a, b));
+        }
+      }
+    }
+  }
+
+  AABB<T> world_;
+  T inv_cell_;
+  int cols_;
+  int rows_;
+
+  std::vector<AABB<T>> boxes_;
+  std::vector<CellRange> ranges_;     // 最後の構築時のセル範囲
+  std::vector<uint32_t> cell_start_;  // セル c の要素は [start[c], start[c+1])
+  std::vector<uint32_t> cell_items_;
+  std::vector<uint8_t> dirty_flag_;
+  std::vector<uint32_t> dirty_;
+  size_t rebuilds_ = 0;
+};
+
+// ============================================================================
+// 3. シミュレーション用のデータ
+// ============================================================================
+
+struct Body {
+  Point2D<float> position;
+  Point2D<float> velocity;
+  float radius;
+};
+
+constexpr float kWorldSize = 1000.0f;
+
+std::vector<Body> make_bodies(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> pos(0.0f, kWorldSize);
+  std::uniform_real_distribution<float> vel(-0.2f, 0.2f);
+  std::uniform_real_distribution<float> rad(0.5f, 1.5f);
+  std::vector<Body> bodies(count);
+  for (auto& b : bodies) {
+    b.position = Point2D{pos(rng), pos(rng)};
+    b.velocity = Point2D{vel(rng), vel(rng)};
+    b.radius = rad(rng);
+  }
+  return bodies;
+}
+
+std::vector<AABB<float>> boxes_of(const std::vector<Body>& bodies) {
+  std::vector<AABB<float>> boxes;
+  boxes.reserve(bodies.size());
+  for (const auto& b : bodies) {
+    boxes.push_back(AABB<float>::around(b.position, b.radius));
+  }
+  return boxes;
+}
+
+std::vector<UniformGrid<float>::Pair> brute_force_pairs(
+    const std::vector<AABB<float>>& boxes) {
+  std::vector<UniformGrid<float>::Pair> pairs;
+  for (uint32_t i = 0; i < boxes.size(); ++i) {
+    for (uint32_t j = i + 1; j < boxes.size(); ++j) {
+      if (boxes[i].overlaps(boxes[j])) {
+        pairs.emplace_back(i, j);
+      }
+    }
+  }
+  return pairs;
+}
+
+template <typename Func>
+double measure_ms(Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count();
+}
+
+const AABB<float> kWorld{{0.0f, 0.0f}, {kWorldSize, kWorldSize}};
+constexpr float kCellSize = 4.0f;  // 最大直径 3.0 より少し大きく
+
+// 大半が止まっていて一部だけが動く場面（stride 個に1個が動く）
+constexpr uint32_t kMoverStride = 100;
+
+void move_some(std::vector<Body>& bodies, UniformGrid<float>& grid,
+               uint32_t stride) {
+  for (uint32_t id = 0; id < bodies.size(); id += stride) {
+    auto& b = bodies[id];
+    b.position.x += b.velocity.x;
+    b.position.y += b.velocity.y;
+    grid.update(id, AABB<float>::around(b.position, b.radius));
+  }
+}
+
+// ============================================================================
+// 4. 総当たりとの比較（結果の一致を確認）
+// ============================================================================
+
+void correctness_example() {
+  std::cout << "=== 総当たりとの比較 (20,000 物体) ===" << std::endl;
+
+  auto bodies = make_bodies(20000, 1);
+  auto boxes = boxes_of(bodies);
+
+  std::vector<UniformGrid<float>::Pair> expected;
+  double brute_ms = measure_ms([&] { expected = brute_force_pairs(boxes); });
+
+  UniformGrid<float> grid(kWorld, kCellSize);
+  std::vector<UniformGrid<float>::Pair> actual;
+  double grid_ms = measure_ms([&] {
+    grid.build(boxes);
+    actual = grid.find_pairs();
+  });
+
+  // 数フレーム動かして差分更新の結果も確認する
+  for (int frame = 0; frame < 20; ++frame) {
+    for (uint32_t id = 0; id < bodies.size(); ++id) {
+      auto& b = bodies[id];
+      b.position.x += b.velocity.x;
+      b.position.y += b.velocity.y;
+      grid.update(id, AABB<float>::around(b.position, b.radius));
+    }
+  }
+  auto moved_expected = brute_force_pairs(boxes_of(bodies));
+  auto moved_actual = grid.find_pairs(4);
+
+  std::sort(actual.begin(), actual.end());
+  std::sort(moved_actual.begin(), moved_actual.end());
+  std::cout << "総当たり: " << brute_ms << " ms, グリッド: " << grid_ms
+            << " ms, ペア数: " << expected.size() << std::endl;
+  std::cout << "構築直後の一致: " << (actual == expected ? "OK" : "NG")
+            << std::endl;
+  std::cout << "20フレーム移動後の一致: "
+            << (moved_actual == moved_expected ? "OK" : "NG")
+            << " (ペア数: " << moved_expected.size()
+            << ", dirty: " << grid.dirty_count() << ")" << std::endl;
+
+  // 一部の物体だけが動く場合は再構築せず、dirty の差分走査だけで求める
+  UniformGrid<float> partial_grid(kWorld, kCellSize);
+  auto partial_bodies = make_bodies(20000, 3);
+  partial_grid.build(boxes_of(partial_bodies));
+  for (int frame = 0; frame < 20; ++frame) {
+    move_some(partial_bodies, partial_grid, kMoverStride);
+  }
+  auto partial_expected = brute_force_pairs(boxes_of(partial_bodies));
+  size_t partial_dirty = partial_grid.dirty_count();
+  auto partial_actual = partial_grid.find_pairs(4);
+  std::sort(partial_actual.begin(), partial_actual.end());
+  std::cout << "1/" << kMoverStride << " だけ20フレーム移動後の一致: "
+            << (partial_actual == partial_expected ? "OK" : "NG")
+            << " (ペア数: " << partial_expected.size()
+            << ", dirty: " << partial_dirty
+            << ", 再構築: " << partial_grid.rebuild_count() << " 回)"
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 5. 10万物体のフレームベンチマーク
+// ============================================================================
+
+void frame_benchmark() {
+  constexpr size_t kBodies = 100000;
+  constexpr int kFrames = 30;
+  std::cout << "=== フレームベンチマーク (" << kBodies << " 物体, " << kFrames
+            << " フレーム) ===" << std::endl;
+
+  auto bodies = make_bodies(kBodies, 2);
+  UniformGrid<float> grid(kWorld, kCellSize);
+  double build_ms = measure_ms([&] { grid.build(boxes_of(bodies)); });
+  std::cout << "初回構築: " << build_ms << " ms (セル数 " << grid.cell_count()
+            << ")" << std::endl;
+
+  for (unsigned threads : {1u, 2u, 4u}) {
+    double update_ms = 0.0;
+    double sweep_ms = 0.0;
+    size_t pairs = 0;
+    size_t rebuilds_before = grid.rebuild_count();
+    for (int frame = 0; frame < kFrames; ++frame) {
+      update_ms += measure_ms([&] {
+        for (uint32_t id = 0; id < bodies.size(); ++id) {
+          auto& b = bodies[id];
+          b.position.x += b.velocity.x;
+          b.position.y += b.velocity.y;
+          grid.update(id, AABB<float>::around(b.position, b.radius));
+        }
+      });
+      sweep_ms += measure_ms([&] { pairs = grid.find_pairs(threads).size(); });
+    }
+    std::cout << std::fixed << std::setprecision(2) << "threads=" << threads
+              << ": 更新 " << update_ms / kFrames << " ms/frame, 走査 "
+              << sweep_ms / kFrames << " ms/frame, ペア数 " << pairs
+              << ", 再構築 " << grid.rebuild_count() - rebuilds_before
+              << " 回" << std::endl;
+  }
+
+  // 一部だけが動く場面: 差分更新と毎フレームの再構築を比べる
+  auto sleepy = make_bodies(kBodies, 4);
+  UniformGrid<float> incremental(kWorld, kCellSize);
+  UniformGrid<float> rebuilt(kWorld, kCellSize);
+  incremental.build(boxes_of(sleepy));
+  double incremental_ms = 0.0;
+  double rebuild_ms = 0.0;
+  size_t mismatched_frames = 0;
+  size_t max_dirty = 0;
+  for (int frame = 0; frame < kFrames; ++frame) {
+    std::vector<UniformGrid<float>::Pair> fast;
+    std::vector<UniformGrid<float>::Pair> full;
+    incremental_ms += measure_ms([&] {
+      move_some(sleepy, incremental, kMoverStride);
+      max_dirty = std::max(max_dirty, incremental.dirty_count());
+      fast = incremental.find_pairs();
+    });
+    rebuild_ms += measure_ms([&] {
+      rebuilt.build(boxes_of(sleepy));
+      full = rebuilt.find_pairs();
+    });
+    std::sort(fast.begin(), fast.end());
+    std::sort(full.begin(), full.end());
+    mismatched_frames += fast != full;
+  }
+  std::cout << "1/" << kMoverStride << " だけ移動: 差分更新 "
+            << incremental_ms / kFrames << " ms/frame (dirty 最大 " << max_dirty
+            << ", 再構築 " << incremental.rebuild_count() - 1
+            << " 回), 毎フレーム再構築 " << rebuild_ms / kFrames
+            << " ms/frame, 不一致 " << mismatched_frames << " フレーム"
+            << std::endl;
+
+  std::cout << "ハードウェアスレッド数: " << std::thread::hardware_concurrency()
+            << std::endl;
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "一様グリッドによるブロードフェーズのサンプル\n" << std::endl;
+
+  correctness_example();
+  frame_benchmark();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
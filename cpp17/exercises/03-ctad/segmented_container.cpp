@@ -0,0 +1,368 @@
+// アドレスが安定するセグメント化 Container（チャンク配列）
+// std::vector は容量が尽きると2倍の領域を確保して全要素をムーブするため、
+// 数千万要素の規模では
+//   - 再確保のたびに一時的に2〜3倍のメモリを使う
+//   - ムーブのコストがその push_back 1回に集中する（レイテンシのスパイク）
+//   - 既存要素のアドレスやイテレータが無効になる
+// という問題がある。SegmentedContainer は固定サイズのブロックを継ぎ足して
+// 伸びるので、既存要素は一切移動しない。
+//
+// ベンチマーク: std::vector / std::deque / SegmentedContainer で追加の
+// スループット、ピークメモリ、最悪の push_back 1回の時間を比較する。
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 0. メモリ使用量の計測（グローバル operator new の置き換え）
+// ============================================================================
+
+// 確保サイズを先頭に記録して、現在の使用量とピークを追跡する
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+std::atomic<size_t> g_current_bytes{0};
+std::atomic<size_t> g_peak_bytes{0};
+
+void* operator new(std::size_t size) {
+  auto* raw = static_cast<unsigned char*>(std::malloc(size + kHeaderSize));
+  if (raw == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<size_t*>(raw) = size;
+  size_t current = g_current_bytes.fetch_add(size) + size;
+  size_t peak = g_peak_bytes.load();
+  while (current > peak && !g_peak_bytes.compare_exchange_weak(peak, current)) {
+  }
+  return raw + kHeaderSize;
+}
+
+void operator delete(void* p) noexcept {
+  if (p == nullptr) {
+    return;
+  }
+  auto* raw = static_cast<unsigned char*>(p) - kHeaderSize;
+  g_current_bytes.fetch_sub(*reinterpret_cast<size_t*>(raw));
+  std::free(raw);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+// ============================================================================
+// 1. SegmentedContainer<T, BlockSize>
+// ============================================================================
+
+// 既定のブロックサイズ: 64KiB 分の要素数（2のべき乗に切り下げ）
+template <typename T>
+constexpr size_t default_block_size() {
+  size_t count = (64 * 1024) / sizeof(T);
+  size_t pow2 = 1;
+  while (pow2 * 2 <= count) {
+    pow2 *= 2;
+  }
+  return pow2;
+}
+
+template <typename T, size_t BlockSize = default_block_size<T>()>
+class SegmentedContainer {
+  static_assert(BlockSize > 0, "BlockSize must be at least 1");
+
+ public:
+  template <bool Const>
+  class Iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+    using Owner = std::conditional_t<Const, const SegmentedContainer,
+                                     SegmentedContainer>;
+
+    Iterator() = default;
+    Iterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+
+    // iterator から const_iterator への変換
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    Iterator(const Iterator<false>& other)  // NOLINT(google-explicit-constructor)
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return &(*owner_)[index_]; }
+    reference operator[](difference_type n) const {
+      return (*owner_)[static_cast<size_t>(
+          static_cast<difference_type>(index_) + n)];
+    }
+
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator copy = *this;
+      ++index_;
+      return copy;
+    }
+    Iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator copy = *this;
+      --index_;
+      return copy;
+    }
+    Iterator& operator+=(difference_type n) {
+      index_ = static_cast<size_t>(static_cast<difference_type>(index_) + n);
+      return *this;
+    }
+    Iterator& operator-=(difference_type n) { return *this += -n; }
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+      return static_cast<difference_type>(a.index_) -
+             static_cast<difference_type>(b.index_);
+    }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) {
+      return a.index_ == b.index_;
+    }
+    friend bool operator!=(const Iterator& a, const Iterator& b) {
+      return a.index_ != b.index_;
+    }
+    friend bool operator<(const Iterator& a, const Iterator& b) {
+      return a.index_ < b.index_;
+    }
+    friend bool operator>(const Iterator& a, const Iterator& b) {
+      return b < a;
+    }
+    friend bool operator<=(const Iterator& a, const Iterator& b) {
+      return !(b < a);
+    }
+    friend bool operator>=(const Iterator& a, const Iterator& b) {
+      return !(a < b);
+    }
+
+   private:
+    friend class Iterator<true>;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;  // 添字で持つので push_back で無効にならない
+  };
+
+  using value_type = T;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  SegmentedContainer() = default;
+
+  // イテレータのペアから構築
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  SegmentedContainer(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  SegmentedContainer(const SegmentedContainer& other)
+      : SegmentedContainer(other.begin(), other.end()) {}
+
+  SegmentedContainer(SegmentedContainer&& other) noexcept { swap(other); }
+
+  SegmentedContainer& operator=(SegmentedContainer other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  void swap(SegmentedContainer& other) noexcept {
+    std::swap(blocks_, other.blocks_);
+    std::swap(size_, other.size_);
+    std::swap(tail_, other.tail_);
+    std::swap(tail_end_, other.tail_end_);
+  }
+
+  ~SegmentedContainer() { clear(); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (tail_ == tail_end_) {
+      // 新しいブロックを継ぎ足す（既存要素は移動しない）。
+      // make_unique は値初期化で 64 KiB をゼロ埋めするので、new Block で
+      // 未初期化のまま確保する
+      blocks_.push_back(std::unique_ptr<Block>(new Block));
+      tail_ = blocks_.back()->slot(0);
+      tail_end_ = tail_ + BlockSize;
+    }
+    T* slot = ::new (static_cast<void*>(tail_)) T(std::forward<Args>(args)...);
+    ++tail_;
+    ++size_;
+    return *slot;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = 0; i < size_; ++i) {
+        (*this)[i].~T();
+      }
+    }
+    size_ = 0;
+    blocks_.clear();
+    tail_ = nullptr;
+    tail_end_ = nullptr;
+  }
+
+  T& operator[](size_t i) { return *element(i); }
+  const T& operator[](size_t i) const { return *element(i); }
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, size_}; }
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, size_}; }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t block_count() const { return blocks_.size(); }
+  static constexpr size_t block_size() { return BlockSize; }
+
+  void print() const {
+    std::cout << "SegmentedContainer elements: ";
+    for (const auto& elem : *this) {
+      std::cout << elem << " ";
+    }
+    std::cout << std::endl;
+  }
+
+ private:
+  struct Block {
+    alignas(T) unsigned char storage[sizeof(T) * BlockSize];
+    T* slot(size_t i) { return reinterpret_cast<T*>(storage) + i; }
+  };
+
+  T* element(size_t i) const {
+    return blocks_[i / BlockSize]->slot(i % BlockSize);
+  }
+
+  std::vector<std::unique_ptr<Block>> blocks_;  // ブロックへのポインタ表
+  size_t size_ = 0;
+  T* tail_ = nullptr;      // 次に構築する位置
+  T* tail_end_ = nullptr;  // 末尾ブロックの終端
+};
+
+// 推論ガイド: イテレータのペアから要素型を推論
+template <typename InputIt,
+          typename = typename std::iterator_traits<InputIt>::iterator_category>
+SegmentedContainer(InputIt, InputIt)
+    -> SegmentedContainer<typename std::iterator_traits<InputIt>::value_type>;
+
+// ============================================================================
+// 2. アドレスとイテレータの安定性
+// ============================================================================
+
+void stability_example() {
+  std::cout << "=== アドレスの安定性 ===" << std::endl;
+
+  std::list<int> source{1, 2, 3, 4, 5};
+  SegmentedContainer c(source.begin(), source.end());  // SegmentedContainer<int>
+  c.print();
+
+  const int* first = &c[0];
+  auto it = c.begin() + 2;
+  for (int i = 0; i < 1000000; ++i) {
+    c.push_back(i);
+  }
+  std::cout << "100万回 push_back 後も &c[0] が同じ: "
+            << (first == &c[0] ? "yes" : "no") << std::endl;
+  std::cout << "保持していたイテレータの値: " << *it << std::endl;
+  std::cout << "ブロック数: " << c.block_count() << " (1ブロック "
+            << c.block_size() << " 要素)" << std::endl;
+
+  // 標準アルゴリズムもそのまま使える
+  std::cout << "最大値: " << *std::max_element(c.begin(), c.end())
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 3. ベンチマーク: 追加スループットとピークメモリ
+// ============================================================================
+
+template <typename Seq>
+void run_append_benchmark(const char* label, size_t count) {
+  size_t baseline = g_current_bytes.load();
+  g_peak_bytes = baseline;
+
+  double worst_us = 0.0;
+  auto begin = std::chrono::steady_clock::now();
+  {
+    Seq seq;
+    auto last = begin;
+    for (size_t i = 0; i < count; ++i) {
+      seq.push_back(static_cast<uint32_t>(i));
+      // 1024 回ごとに区間の最大時間を記録する（再確保のスパイク検出）
+      if ((i & 1023) == 1023) {
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::micro> span = now - last;
+        worst_us = std::max(worst_us, span.count());
+        last = now;
+      }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    double final_mb = static_cast<double>(g_current_bytes - baseline) / 1e6;
+    double peak_mb = static_cast<double>(g_peak_bytes - baseline) / 1e6;
+    std::cout << std::left << std::setw(20) << label << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << static_cast<double>(count) / elapsed.count() / 1e6
+              << std::setw(12) << final_mb << std::setw(12) << peak_mb
+              << std::setw(14) << worst_us << std::endl;
+  }
+}
+
+void append_benchmark() {
+  constexpr size_t kCount = 20000000;
+  std::cout << "=== 追加ベンチマーク (uint32_t x " << kCount << ") ==="
+            << std::endl;
+  std::cout << std::left << std::setw(20) << "container" << std::right
+            << std::setw(10) << "M/s" << std::setw(12) << "final MB"
+            << std::setw(12) << "peak MB" << std::setw(14)
+            << "worst/1K us" << std::endl;
+
+  run_append_benchmark<std::vector<uint32_t>>("std::vector", kCount);
+  run_append_benchmark<std::deque<uint32_t>>("std::deque", kCount);
+  run_append_benchmark<SegmentedContainer<uint32_t>>("SegmentedContainer",
+                                                     kCount);
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "セグメント化 Container のサンプル\n" << std::endl;
+
+  stability_example();
+  append_benchmark();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
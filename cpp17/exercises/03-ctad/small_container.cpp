@@ -0,0 +1,401 @@
+// インライン領域を持つ Container<T, N>（スモールバッファ最適化）
+// example.cpp の Container<T> は中身が1要素でも必ず std::vector で
+// ヒープ確保を行い、イテレータのペアから作るときも入力イテレータと
+// 前方イテレータを区別しない。
+// ここでは N 要素分の領域をオブジェクト内に持ち、あふれたときだけ
+// ヒープへ移る Container<T, N> を作る。
+//   - 前方/ランダムアクセスイテレータなら std::distance で一度だけ確保
+//   - 入力イテレータなら push_back で伸ばす
+//   - 推論ガイドで T を推論し、N は T の大きさから既定値を決める
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 0. ヒープ確保回数の計測（グローバル operator new の置き換え）
+// ============================================================================
+
+std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ============================================================================
+// 1. Container<T, N>
+// ============================================================================
+
+// 既定のインライン要素数: 256 バイト以内で最大 16 要素
+template <typename T>
+constexpr size_t default_inline_capacity() {
+  constexpr size_t by_size = 256 / sizeof(T);
+  return by_size == 0 ? 1 : (by_size > 16 ? 16 : by_size);
+}
+
+template <typename T, size_t N = default_inline_capacity<T>()>
+class Container {
+  static_assert(N > 0, "inline capacity must be at least 1");
+
+ public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  Container() = default;
+
+  Container(std::initializer_list<T> init) {
+    reserve(init.size());
+    for (const auto& elem : init) {
+      emplace_back(elem);
+    }
+  }
+
+  explicit Container(std::vector<T> elems) {
+    reserve(elems.size());
+    for (auto& elem : elems) {
+      emplace_back(std::move(elem));
+    }
+  }
+
+  // イテレータのペアから構築
+  template <typename Iterator,
+            typename = typename std::iterator_traits<Iterator>::iterator_category>
+  Container(Iterator first, Iterator last) {
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+      // 要素数が事前にわかるので、ちょうどの大きさを一度だけ確保する
+      reserve(static_cast<size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  Container(const Container& other) {
+    reserve(other.size_);
+    for (const auto& elem : other) {
+      emplace_back(elem);
+    }
+  }
+
+  Container(Container&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    steal(std::move(other));
+  }
+
+  Container& operator=(const Container& other) {
+    if (this != &other) {
+      Container copy(other);
+      clear_and_release();
+      steal(std::move(copy));
+    }
+    return *this;
+  }
+
+  Container& operator=(Container&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear_and_release();
+      steal(std::move(other));
+    }
+    return *this;
+  }
+
+  ~Container() { clear_and_release(); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      return grow_and_emplace(capacity_ * 2, std::forward<Args>(args)...);
+    }
+    T* slot = ::new (static_cast<void*>(data_ + size_))
+        T(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      grow(capacity);
+    }
+  }
+
+  void clear() {
+    std::destroy(data_, data_ + size_);
+    size_ = 0;
+  }
+
+  T& operator[](size_t i) { return data_[i]; }
+  const T& operator[](size_t i) const { return data_[i]; }
+
+  iterator begin() { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  bool is_inline() const { return data_ == inline_data(); }
+  static constexpr size_t inline_capacity() { return N; }
+
+  void print() const {
+    std::cout << "Container elements: ";
+    for (const auto& elem : *this) {
+      std::cout << elem << " ";
+    }
+    std::cout << std::endl;
+  }
+
+ private:
+  T* inline_data() { return reinterpret_cast<T*>(storage_); }
+  const T* inline_data() const { return reinterpret_cast<const T*>(storage_); }
+
+  void grow(size_t new_capacity) {
+    new_capacity = std::max(new_capacity, N);
+    std::allocator<T> alloc;
+    T* fresh = alloc.allocate(new_capacity);
+    try {
+      relocate_to(fresh);
+    } catch (...) {
+      alloc.deallocate(fresh, new_capacity);
+      throw;
+    }
+    adopt(fresh, new_capacity);
+  }
+
+  // c.push_back(c[0]) のように引数が自分の要素を指していることがあるので、
+  // 古い要素を移す前に新しい領域の末尾へ新しい要素を作る
+  template <typename... Args>
+  T& grow_and_emplace(size_t new_capacity, Args&&... args) {
+    new_capacity = std::max(new_capacity, N);
+    std::allocator<T> alloc;
+    T* fresh = alloc.allocate(new_capacity);
+    T* slot = nullptr;
+    try {
+      slot = ::new (static_cast<void*>(fresh + size_))
+          T(std::forward<Args>(args)...);
+      relocate_to(fresh);
+    } catch (...) {
+      if (slot != nullptr) {
+        slot->~T();
+      }
+      alloc.deallocate(fresh, new_capacity);
+      throw;
+    }
+    adopt(fresh, new_capacity);
+    ++size_;
+    return *slot;
+  }
+
+  // 今の要素を fresh へ移す（ムーブが例外を投げうるならコピー）
+  void relocate_to(T* fresh) {
+    if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                  !std::is_copy_constructible_v<T>) {
+      std::uninitialized_move(data_, data_ + size_, fresh);
+    } else {
+      std::uninitialized_copy(data_, data_ + size_, fresh);
+    }
+  }
+
+  // 古い要素を破棄して fresh に切り替える
+  void adopt(T* fresh, size_t new_capacity) {
+    std::destroy(data_, data_ + size_);
+    release_heap();
+    data_ = fresh;
+    capacity_ = new_capacity;
+  }
+
+  void release_heap() {
+    if (!is_inline()) {
+      std::allocator<T>().deallocate(data_, capacity_);
+    }
+    data_ = inline_data();
+    capacity_ = N;
+  }
+
+  void clear_and_release() {
+    clear();
+    release_heap();
+  }
+
+  // other の中身を受け取る（this は空でインライン状態であること）
+  void steal(Container&& other) {
+    if (other.is_inline()) {
+      std::uninitialized_move(other.data_, other.data_ + other.size_, data_);
+      size_ = other.size_;
+      other.clear();
+    } else {
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.data_ = other.inline_data();
+      other.size_ = 0;
+      other.capacity_ = N;
+    }
+  }
+
+  alignas(T) std::byte storage_[sizeof(T) * N];
+  T* data_ = inline_data();
+  size_t size_ = 0;
+  size_t capacity_ = N;
+};
+
+// 推論ガイド: イテレータのペアから要素型を推論（N は既定値）
+template <typename Iterator,
+          typename = typename std::iterator_traits<Iterator>::iterator_category>
+Container(Iterator, Iterator)
+    -> Container<typename std::iterator_traits<Iterator>::value_type>;
+
+template <typename T>
+Container(std::vector<T>) -> Container<T>;
+
+// ============================================================================
+// 2. CTAD とインライン領域
+// ============================================================================
+
+void deduction_example() {
+  std::cout << "=== 推論ガイドとインライン領域 ===" << std::endl;
+
+  std::vector<int> v{1, 2, 3, 4, 5};
+
+  size_t before = g_allocations;
+  Container c1(v.begin(), v.end());  // Container<int, 16>
+  std::cout << "c1: inline_capacity=" << c1.inline_capacity()
+            << ", is_inline=" << c1.is_inline()
+            << ", ヒープ確保=" << g_allocations - before << std::endl;
+  c1.print();
+
+  Container c2{std::string("a"), std::string("b")};  // Container<std::string, 8>
+  std::cout << "c2: inline_capacity=" << c2.inline_capacity() << std::endl;
+
+  Container c3(std::vector{10, 20, 30});
+  c3.print();
+
+  // 明示的に N を指定することもできる
+  Container<int, 2> small{1, 2};
+  small.push_back(3);  // あふれてヒープへ
+  std::cout << "Container<int, 2> に3要素: is_inline=" << small.is_inline()
+            << ", capacity=" << small.capacity() << std::endl;
+
+  // 満杯のときに自分の要素を push_back する（インライン → ヒープ、ヒープ → ヒープ）
+  Container<std::string, 2> names{std::string("alpha"), std::string("beta")};
+  names.push_back(names[0]);
+  names.push_back(names[1]);
+  names.push_back(names[2]);
+  std::cout << "自分の要素を追加: ";
+  names.print();
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 3. イテレータの種類による事前確保
+// ============================================================================
+
+void iterator_category_example() {
+  std::cout << "=== イテレータの種類と確保回数 ===" << std::endl;
+
+  std::vector<int> source(100);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = static_cast<int>(i);
+  }
+
+  // ランダムアクセスイテレータ: 要素数が事前にわかる
+  size_t before = g_allocations;
+  Container<int, 4> from_vector(source.begin(), source.end());
+  std::cout << "ランダムアクセス: ヒープ確保 " << g_allocations - before
+            << " 回, capacity=" << from_vector.capacity() << std::endl;
+
+  // 入力イテレータ: 要素数がわからないので倍々で伸ばす
+  std::ostringstream text;
+  for (int x : source) {
+    text << x << ' ';
+  }
+  std::istringstream in(text.str());
+  before = g_allocations;
+  Container<int, 4> from_stream(std::istream_iterator<int>(in),
+                                std::istream_iterator<int>{});
+  std::cout << "入力イテレータ: ヒープ確保 " << g_allocations - before
+            << " 回, capacity=" << from_stream.capacity() << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 4. ベンチマーク: 小さなコンテナを大量に作る
+// ============================================================================
+
+template <typename Make>
+void run_benchmark(const char* label, Make&& make) {
+  constexpr int kIterations = 1000000;
+  size_t before = g_allocations;
+  auto begin = std::chrono::steady_clock::now();
+  long long checksum = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    checksum += make(i);
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << label << ": " << elapsed.count() << " ms, ヒープ確保 "
+            << g_allocations - before << " 回 (checksum " << checksum << ")"
+            << std::endl;
+}
+
+void benchmark_example() {
+  std::cout << "=== ベンチマーク（8要素 x 1,000,000 回）===" << std::endl;
+
+  const int source[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  run_benchmark("std::vector<int>  ", [&](int i) {
+    std::vector<int> v(std::begin(source), std::end(source));
+    v.push_back(i);
+    return static_cast<long long>(v.size()) + v[8];
+  });
+
+  run_benchmark("Container<int, 16>", [&](int i) {
+    Container c(std::begin(source), std::end(source));
+    c.push_back(i);
+    return static_cast<long long>(c.size()) + c[8];
+  });
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "インライン領域付き Container<T, N> のサンプル\n" << std::endl;
+
+  deduction_example();
+  iterator_category_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
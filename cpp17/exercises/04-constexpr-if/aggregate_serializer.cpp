@@ -0,0 +1,321 @@
+// 集成体の自動シリアライズ
+// binary_serializer.h の constexpr if による分岐に集成体を加えたもののサンプル。
+//   - T{any_field{}, ...} でメンバ数をコンパイル時に検出
+//   - 構造化束縛で分解してメンバごとに再帰的に書く/読む
+//   - 手書きのシリアライザ（memcpy で直接書くもの）と速度を比較する
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "binary_serializer.h"
+
+// ============================================================================
+// 1. 対象の構造体（cpp20 の 09-designated-initializers / 01-concepts と同じ形）
+// ============================================================================
+
+struct CharacterStats {
+  std::string name;
+  int level = 1;
+  int health = 100;
+  int mana = 50;
+  int attack = 10;
+  int defense = 5;
+};
+
+struct GraphicsSettings {
+  int resolution_width = 1920;
+  int resolution_height = 1080;
+  bool vsync = true;
+  int anti_aliasing = 4;
+  int shadow_quality = 3;
+};
+
+struct GameSettings {
+  GraphicsSettings graphics;
+  float master_volume = 1.0f;
+  float music_volume = 0.8f;
+  float sfx_volume = 0.9f;
+  bool show_fps = false;
+};
+
+struct SaveData {
+  int level = 1;
+  int score = 0;
+  CharacterStats character;
+  GameSettings settings;
+  std::vector<uint32_t> inventory;
+};
+
+// パディングのない trivially copyable な集成体は丸ごと memcpy される
+struct TileCoord {
+  int32_t x;
+  int32_t y;
+  uint32_t layer;
+};
+
+static_assert(binary::aggregate_arity<CharacterStats>() == 6);
+static_assert(binary::aggregate_arity<GraphicsSettings>() == 5);
+static_assert(binary::aggregate_arity<GameSettings>() == 5);
+static_assert(binary::aggregate_arity<SaveData>() == 5);
+static_assert(binary::is_raw_copyable_v<TileCoord>);
+static_assert(!binary::is_raw_copyable_v<GraphicsSettings>);  // bool の後ろにパディング
+
+// パディングはないが bool を含むので、読み取りは memcpy せずメンバごとに行う
+struct SpriteFlags {
+  bool visible;
+  uint8_t layer;
+};
+
+static_assert(binary::is_raw_readable_v<TileCoord>);
+static_assert(!binary::is_raw_readable_v<SpriteFlags>);
+
+// ============================================================================
+// 2. 手書きのシリアライザ（比較用）
+// ============================================================================
+
+// バッファの大きさは呼び出し側が保証する前提で、境界チェックなしに
+// memcpy で直接書く。ワイヤ形式は自動版と同じ
+class RawCursor {
+ public:
+  explicit RawCursor(std::byte* out) : out_(out) {}
+
+  template <typename T>
+  void put(const T& value) {
+    std::memcpy(out_, &value, sizeof(T));
+    out_ += sizeof(T);
+  }
+
+  void put_bytes(const void* data, size_t size) {
+    std::memcpy(out_, data, size);
+    out_ += size;
+  }
+
+  void put_string(const std::string& text) {
+    put(static_cast<uint32_t>(text.size()));
+    put_bytes(text.data(), text.size());
+  }
+
+  std::byte* position() const { return out_; }
+
+ private:
+  std::byte* out_;
+};
+
+void handwritten_write(RawCursor& out, const SaveData& save) {
+  out.put(save.level);
+  out.put(save.score);
+
+  const auto& c = save.character;
+  out.put_string(c.name);
+  out.put(c.level);
+  out.put(c.health);
+  out.put(c.mana);
+  out.put(c.attack);
+  out.put(c.defense);
+
+  const auto& g = save.settings.graphics;
+  out.put(g.resolution_width);
+  out.put(g.resolution_height);
+  out.put(g.vsync);
+  out.put(g.anti_aliasing);
+  out.put(g.shadow_quality);
+  out.put(save.settings.master_volume);
+  out.put(save.settings.music_volume);
+  out.put(save.settings.sfx_volume);
+  out.put(save.settings.show_fps);
+
+  out.put(static_cast<uint32_t>(save.inventory.size()));
+  out.put_bytes(save.inventory.data(),
+                save.inventory.size() * sizeof(uint32_t));
+}
+
+// ============================================================================
+// 3. 基本的な使い方
+// ============================================================================
+
+SaveData make_save(uint32_t seed) {
+  SaveData save;
+  save.level = static_cast<int>(seed % 60) + 1;
+  save.score = static_cast<int>(seed * 37);
+  save.character = {"Hero_" + std::to_string(seed), save.level, 120, 80, 15, 9};
+  save.settings.graphics.vsync = seed % 2 == 0;
+  save.settings.music_volume = 0.5f;
+  save.inventory = {seed, seed + 1, seed + 2, seed + 3, seed + 4, seed + 5};
+  return save;
+}
+
+void roundtrip_example() {
+  std::cout << "=== 集成体のラウンドトリップ ===" << std::endl;
+
+  SaveData save = make_save(7);
+
+  std::vector<std::byte> buffer;
+  binary::BinaryWriter writer(binary::VectorSink{buffer});
+  writer.write(save);  // 手書きコードなしで全メンバを書く
+  std::cout << "SaveData: " << buffer.size() << " バイト" << std::endl;
+
+  binary::BinaryReader reader(buffer);
+  auto loaded = reader.read<SaveData>();
+  if (!loaded) {
+    std::cout << "読み取り失敗" << std::endl;
+    return;
+  }
+  std::cout << "name=" << loaded->character.name
+            << ", level=" << loaded->level << ", score=" << loaded->score
+            << ", resolution=" << loaded->settings.graphics.resolution_width
+            << "x" << loaded->settings.graphics.resolution_height
+            << ", music=" << loaded->settings.music_volume
+            << ", inventory=" << loaded->inventory.size() << " 個"
+            << std::endl;
+
+  // 手書き版と同じバイト列になる
+  std::vector<std::byte> manual(buffer.size());
+  RawCursor cursor(manual.data());
+  handwritten_write(cursor, save);
+  std::cout << "手書き版とのバイト一致: "
+            << (std::memcmp(manual.data(), buffer.data(), buffer.size()) == 0
+                    ? "OK"
+                    : "NG")
+            << std::endl;
+
+  // 途中で切れたデータは nullopt
+  binary::BinaryReader truncated(
+      std::span<const std::byte>(buffer).first(buffer.size() / 2));
+  std::cout << "途中で切れたデータ: "
+            << (truncated.read<SaveData>() ? "読めた" : "nullopt") << std::endl;
+
+  // memcpy 経路
+  TileCoord tile{3, -4, 2};
+  std::vector<std::byte> tile_bytes;
+  binary::BinaryWriter tile_writer(binary::VectorSink{tile_bytes});
+  tile_writer.write(tile);
+  binary::BinaryReader tile_reader(tile_bytes);
+  auto tile_back = tile_reader.read<TileCoord>();
+  std::cout << "TileCoord: " << tile_bytes.size() << " バイト -> ("
+            << tile_back->x << ", " << tile_back->y << ", " << tile_back->layer
+            << ")" << std::endl;
+
+  // bool のメンバに 0 / 1 以外のバイトが来たら読み取り失敗
+  const std::byte good_flags[] = {std::byte{1}, std::byte{3}};
+  const std::byte bad_flags[] = {std::byte{7}, std::byte{3}};
+  binary::BinaryReader good_reader(good_flags);
+  binary::BinaryReader bad_reader(bad_flags);
+  auto good = good_reader.read<SpriteFlags>();
+  auto bad = bad_reader.read<SpriteFlags>();
+  std::cout << "SpriteFlags {1, 3}: visible=" << good->visible
+            << " layer=" << int{good->layer} << " / {7, 3}: "
+            << (bad ? "読めた" : "nullopt") << ", ok=" << bad_reader.ok()
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 4. ベンチマーク: 自動生成 vs 手書き memcpy
+// ============================================================================
+
+template <typename Func>
+double measure_ms(Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count();
+}
+
+void benchmark_example() {
+  constexpr size_t kSaves = 100000;
+  constexpr int kRounds = 20;
+  std::cout << "=== ベンチマーク（SaveData " << kSaves << " 件 x " << kRounds
+            << " 回）===" << std::endl;
+
+  std::vector<SaveData> saves;
+  saves.reserve(kSaves);
+  for (size_t i = 0; i < kSaves; ++i) {
+    saves.push_back(make_save(static_cast<uint32_t>(i)));
+  }
+
+  // 必要なバイト数を一度測っておく
+  std::vector<std::byte> sizing;
+  {
+    binary::BinaryWriter writer(binary::VectorSink{sizing});
+    for (const auto& save : saves) {
+      writer.write(save);
+    }
+  }
+  std::vector<std::byte> automatic(sizing.size());
+  std::vector<std::byte> manual(sizing.size());
+
+  size_t auto_size = 0;
+  double auto_ms = measure_ms([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      binary::BinaryWriter writer(binary::SpanSink{automatic});
+      for (const auto& save : saves) {
+        writer.write(save);
+      }
+      auto_size = writer.size();
+    }
+  });
+
+  size_t manual_size = 0;
+  double manual_ms = measure_ms([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      RawCursor cursor(manual.data());
+      for (const auto& save : saves) {
+        handwritten_write(cursor, save);
+      }
+      manual_size = static_cast<size_t>(cursor.position() - manual.data());
+    }
+  });
+
+  std::cout << "自動（集成体分解, 境界チェックあり）: " << auto_ms << " ms"
+            << std::endl;
+  std::cout << "手書き（memcpy, 境界チェックなし）  : " << manual_ms << " ms"
+            << std::endl;
+  std::cout << "比率: " << auto_ms / manual_ms << std::endl;
+  std::cout << "出力の一致: "
+            << (auto_size == manual_size &&
+                        std::memcmp(automatic.data(), manual.data(),
+                                    auto_size) == 0
+                    ? "OK"
+                    : "NG")
+            << std::endl;
+
+  uint64_t checksum = 0;
+  double read_ms = measure_ms([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      binary::BinaryReader reader(
+          std::span<const std::byte>(automatic).first(auto_size));
+      while (reader.remaining() > 0) {
+        auto save = reader.read<SaveData>();
+        if (!save) {
+          break;
+        }
+        checksum += static_cast<uint64_t>(save->score) + save->inventory.size();
+      }
+    }
+  });
+  std::cout << "自動の読み取り: " << read_ms << " ms (checksum " << checksum
+            << ")" << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "集成体の自動シリアライズのサンプル\n" << std::endl;
+
+  roundtrip_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,145 @@
+// batch_calculate.h のサンプルとベンチマーク
+//   - 検出した ISA レベルの表示
+//   - バッチ版とスカラー版の結果が一致することの確認
+//   - ISA レベルごとのスループット
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "batch_calculate.h"
+
+using batch::IsaLevel;
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== バッチ版 calculate ===" << std::endl;
+  std::cout << "この CPU で使える最上位の ISA: "
+            << batch::to_string(batch::supported_isa()) << std::endl;
+
+  std::vector<int> ints{1, 2, 3, 4, 5};
+  std::vector<int> doubled(ints.size());
+  batch::calculate(std::span<const int>(ints), std::span<int>(doubled));
+  std::cout << "int x2: ";
+  for (int value : doubled) {
+    std::cout << value << " ";
+  }
+  std::cout << std::endl;
+
+  // float の結果は calculate<float> と同じく double
+  std::vector<float> floats{1.0f, 2.0f, 3.14f};
+  std::vector<batch::calculate_result_t<float>> scaled(floats.size());
+  batch::calculate(std::span<const float>(floats),
+                   std::span<double>(scaled));
+  std::cout << "float x2.5: ";
+  for (double value : scaled) {
+    std::cout << value << " ";
+  }
+  std::cout << std::endl;
+
+  try {
+    std::vector<int> too_small(2);
+    batch::calculate(std::span<const int>(ints), std::span<int>(too_small));
+  } catch (const std::length_error& e) {
+    std::cout << "出力が短い場合: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. ベンチマーク
+// ============================================================================
+
+template <typename T>
+std::vector<T> make_input(size_t size) {
+  std::vector<T> values(size);
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<T>(i % 1000) / static_cast<T>(3);
+  }
+  return values;
+}
+
+template <typename T>
+const char* type_name() {
+  if constexpr (std::is_same_v<T, int32_t>) {
+    return "int32 -> int32  ";
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return "int64 -> int64  ";
+  } else if constexpr (std::is_same_v<T, float>) {
+    return "float -> double ";
+  } else {
+    return "double -> double";
+  }
+}
+
+template <typename T>
+void benchmark_type() {
+  using R = batch::calculate_result_t<T>;
+  // L1 に収まる大きさにして、メモリ帯域で頭打ちにならないようにする
+  constexpr size_t kSize = 1 << 12;
+  constexpr int kRounds = 40000;
+
+  auto input = make_input<T>(kSize);
+  std::vector<R> expected(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    expected[i] = batch::calculate(input[i]);
+  }
+
+  std::cout << type_name<T>() << ":";
+  for (IsaLevel level : {IsaLevel::kScalar, IsaLevel::kSse42, IsaLevel::kAvx2,
+                         IsaLevel::kAvx512}) {
+    if (level > batch::supported_isa()) {
+      std::cout << "  " << batch::to_string(level) << " -";
+      continue;
+    }
+    std::vector<R> output(kSize);
+    auto begin = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+      batch::calculate(std::span<const T>(input), std::span<R>(output), level);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    double gvalues =
+        static_cast<double>(kSize) * kRounds / elapsed.count() / 1e9;
+    std::cout << "  " << batch::to_string(level) << " " << std::fixed
+              << std::setprecision(2) << gvalues << std::defaultfloat
+              << (output == expected ? "" : "(NG)");
+  }
+  std::cout << "  G値/s" << std::endl;
+}
+
+void benchmark_example() {
+  std::cout << "=== ベンチマーク（ISA レベルごとのスループット）==="
+            << std::endl;
+
+  benchmark_type<int32_t>();
+  benchmark_type<int64_t>();
+  benchmark_type<float>();
+  benchmark_type<double>();
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "calculate<T> のバッチ版と実行時 CPU ディスパッチのサンプル\n"
+            << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,207 @@
+// calculate<T> のバッチ版と実行時 CPU ディスパッチ
+// solution.cpp の calculate<T> は1値ずつ value * 2 / value * 2.5 を返す。
+// ここでは calculate(std::span<const T>, std::span<R>) を用意し、
+//   - 整数/浮動小数点のカーネルは constexpr if で選ぶ
+//   - 同じカーネルを AVX-512 / AVX2 / SSE4.2 / スカラー向けに
+//     target 属性で別々にコンパイルし（関数のマルチバージョン化）、
+//     実行時に CPUID で選んだものを関数ポインタ経由で呼ぶ
+// ので、1つのバイナリがどの世代の CPU でもその CPU の最良の命令で動く。
+//
+// ベクトル化そのものはコンパイラに任せ、ISA ごとの違いは target 属性だけで
+// 表す。x86-64 の GCC/Clang 以外ではすべてスカラー版になる。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_CALCULATE_MULTIVERSION 1
+#define BATCH_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace batch {
+
+// ============================================================================
+// スカラー版（solution.cpp と同じ）
+// ============================================================================
+
+template <typename T>
+auto calculate(T value) {
+  if constexpr (std::is_integral_v<T>) {
+    return value * 2;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return value * 2.5;
+  } else {
+    static_assert(!std::is_same_v<T, T>, "この型は計算できません");
+  }
+}
+
+template <typename T>
+using calculate_result_t = decltype(calculate(std::declval<T>()));
+
+// ============================================================================
+// ISA レベルの検出
+// ============================================================================
+
+enum class IsaLevel { kScalar, kSse42, kAvx2, kAvx512 };
+
+inline const char* to_string(IsaLevel level) {
+  switch (level) {
+    case IsaLevel::kScalar:
+      return "scalar";
+    case IsaLevel::kSse42:
+      return "SSE4.2";
+    case IsaLevel::kAvx2:
+      return "AVX2";
+    case IsaLevel::kAvx512:
+      return "AVX-512";
+  }
+  return "unknown";
+}
+
+// CPUID（と OS による AVX 状態の保存）を確認して使える最上位の ISA を返す
+inline IsaLevel detect_isa() {
+#if defined(BATCH_CALCULATE_MULTIVERSION)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+      __builtin_cpu_supports("avx512dq")) {
+    return IsaLevel::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return IsaLevel::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return IsaLevel::kSse42;
+  }
+#endif
+  return IsaLevel::kScalar;
+}
+
+inline IsaLevel supported_isa() {
+  static const IsaLevel level = detect_isa();
+  return level;
+}
+
+// ============================================================================
+// カーネル
+// ============================================================================
+
+namespace detail {
+
+template <typename T, typename R>
+using Kernel = void (*)(const T*, R*, size_t);
+
+// スカラー版はベクトル化を止める（比較の基準にするため）
+template <typename T, typename R>
+#if defined(__clang__)
+void calculate_scalar(const T* in, R* out, size_t size) {
+#pragma clang loop vectorize(disable)
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<R>(calculate(in[i]));
+  }
+}
+#elif defined(__GNUC__)
+__attribute__((optimize("no-tree-vectorize"))) void calculate_scalar(
+    const T* in, R* out, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<R>(calculate(in[i]));
+  }
+}
+#else
+void calculate_scalar(const T* in, R* out, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<R>(calculate(in[i]));
+  }
+}
+#endif
+
+#if defined(BATCH_CALCULATE_MULTIVERSION)
+
+// ループ本体。各 ISA 版の関数にインライン展開され、その関数の
+// target 属性に従ってベクトル化される
+template <typename T, typename R>
+__attribute__((always_inline)) inline void calculate_loop(const T* in, R* out,
+                                                          size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    if constexpr (std::is_integral_v<T>) {
+      out[i] = static_cast<R>(in[i] * 2);
+    } else {
+      // float も double に広げてから掛ける（calculate<float> と同じ結果）
+      out[i] = static_cast<R>(static_cast<double>(in[i]) * 2.5);
+    }
+  }
+}
+
+template <typename T, typename R>
+BATCH_TARGET("sse4.2")
+void calculate_sse42(const T* in, R* out, size_t size) {
+  calculate_loop(in, out, size);
+}
+
+template <typename T, typename R>
+BATCH_TARGET("avx2")
+void calculate_avx2(const T* in, R* out, size_t size) {
+  calculate_loop(in, out, size);
+}
+
+template <typename T, typename R>
+BATCH_TARGET("avx512f,avx512vl,avx512dq,prefer-vector-width=512")
+void calculate_avx512(const T* in, R* out, size_t size) {
+  calculate_loop(in, out, size);
+}
+
+#endif
+
+// level 以下で使える最良のカーネル
+template <typename T, typename R>
+Kernel<T, R> select_kernel(IsaLevel level) {
+#if defined(BATCH_CALCULATE_MULTIVERSION)
+  if (level > supported_isa()) {
+    level = supported_isa();
+  }
+  switch (level) {
+    case IsaLevel::kAvx512:
+      return &calculate_avx512<T, R>;
+    case IsaLevel::kAvx2:
+      return &calculate_avx2<T, R>;
+    case IsaLevel::kSse42:
+      return &calculate_sse42<T, R>;
+    case IsaLevel::kScalar:
+      break;
+  }
+#else
+  static_cast<void>(level);
+#endif
+  return &calculate_scalar<T, R>;
+}
+
+}  // namespace detail
+
+// ============================================================================
+// バッチ版
+// ============================================================================
+
+// out[i] = calculate(in[i])。level を省略すると CPU が対応する最上位の ISA
+template <typename T, typename R>
+void calculate(std::span<const T> in, std::span<R> out,
+               IsaLevel level = IsaLevel::kAvx512) {
+  static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>,
+                "calculate のバッチ版は算術型のみ");
+  if (out.size() < in.size()) {
+    throw std::length_error("calculate: 出力 span が入力より短い");
+  }
+  // 既定（最上位の ISA）のカーネルは型ごとに一度だけ選ぶ
+  if (level >= supported_isa()) {
+    static const auto best = detail::select_kernel<T, R>(supported_isa());
+    best(in.data(), out.data(), in.size());
+  } else {
+    detail::select_kernel<T, R>(level)(in.data(), out.data(), in.size());
+  }
+}
+
+}  // namespace batch
@@ -0,0 +1,313 @@
+// binary_serializer.h のサンプルとベンチマーク
+//   - 固定長バッファ（std::span）と再利用バッファへの書き込み
+//   - std::string_view を返すゼロコピーの読み取りと境界チェック
+//   - example.cpp 方式の serialize<T>（1バイトずつ push_back）との比較
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "binary_serializer.h"
+
+// ============================================================================
+// 1. 比較用: example.cpp と同じ serialize<T>
+// ============================================================================
+
+template <typename T>
+std::vector<uint8_t> legacy_serialize(const T& value) {
+  std::vector<uint8_t> result;
+
+  if constexpr (std::is_integral_v<T>) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      result.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFF));
+    }
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    size_t len = value.size();
+    for (size_t i = 0; i < 4; ++i) {
+      result.push_back(static_cast<uint8_t>((len >> (i * 8)) & 0xFF));
+    }
+    for (char c : value) {
+      result.push_back(static_cast<uint8_t>(c));
+    }
+  } else if constexpr (std::is_floating_point_v<T>) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      result.push_back(bytes[i]);
+    }
+  } else {
+    static_assert(!std::is_same_v<T, T>, "この型はシリアライズできません");
+  }
+
+  return result;
+}
+
+// ============================================================================
+// 2. 状態データ
+// ============================================================================
+
+struct PlayerState {
+  uint32_t id;
+  int32_t hp;
+  float x;
+  float y;
+  float z;
+  std::string name;
+  std::vector<float> cooldowns;
+};
+
+template <typename Sink>
+void write_player(binary::BinaryWriter<Sink>& writer, const PlayerState& p) {
+  writer.write(p.id).write(p.hp).write(p.x).write(p.y).write(p.z);
+  writer.write(p.name).write(p.cooldowns);
+}
+
+void append(std::vector<uint8_t>& out, const std::vector<uint8_t>& bytes) {
+  out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+void legacy_write_player(std::vector<uint8_t>& out, const PlayerState& p) {
+  append(out, legacy_serialize(p.id));
+  append(out, legacy_serialize(p.hp));
+  append(out, legacy_serialize(p.x));
+  append(out, legacy_serialize(p.y));
+  append(out, legacy_serialize(p.z));
+  append(out, legacy_serialize(p.name));
+  append(out, legacy_serialize(static_cast<uint32_t>(p.cooldowns.size())));
+  for (float cd : p.cooldowns) {
+    append(out, legacy_serialize(cd));
+  }
+}
+
+// ビューで受け取る版（name は元バッファを指す）
+struct PlayerView {
+  uint32_t id;
+  int32_t hp;
+  float x;
+  float y;
+  float z;
+  std::string_view name;
+};
+
+bool read_player(binary::BinaryReader& reader, PlayerView& out,
+                 std::vector<float>& cooldowns) {
+  auto id = reader.read<uint32_t>();
+  auto hp = reader.read<int32_t>();
+  auto x = reader.read<float>();
+  auto y = reader.read<float>();
+  auto z = reader.read<float>();
+  auto name = reader.read<std::string_view>();
+  if (!reader.read_vector(cooldowns) || !reader.ok()) {
+    return false;
+  }
+  out = PlayerView{*id, *hp, *x, *y, *z, *name};
+  return true;
+}
+
+std::vector<PlayerState> make_players(size_t count) {
+  std::vector<PlayerState> players;
+  players.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    PlayerState p;
+    p.id = static_cast<uint32_t>(i);
+    p.hp = static_cast<int32_t>(100 + i % 50);
+    p.x = static_cast<float>(i) * 0.5f;
+    p.y = static_cast<float>(i % 100);
+    p.z = -1.0f;
+    p.name = "player_" + std::to_string(i);
+    p.cooldowns.assign(8, static_cast<float>(i % 7));
+    players.push_back(std::move(p));
+  }
+  return players;
+}
+
+// ============================================================================
+// 3. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 固定長バッファへの書き込み ===" << std::endl;
+
+  std::array<std::byte, 64> storage{};
+  binary::BinaryWriter writer(binary::SpanSink{storage});
+  writer.write(uint32_t{42}).write(std::string("Hi")).write(3.14f);
+  std::cout << "書き込みバイト数: " << writer.size() << std::endl;
+  std::cout << "バイト列: ";
+  for (std::byte b : writer.written()) {
+    std::cout << std::to_integer<int>(b) << " ";
+  }
+  std::cout << std::endl;
+
+  binary::BinaryReader reader(writer.written());
+  auto number = reader.read<uint32_t>();
+  auto text = reader.read<std::string_view>();
+  auto real = reader.read<float>();
+  std::cout << "読み取り: " << *number << ", \"" << *text << "\", " << *real
+            << std::endl;
+  std::cout << "string_view は元バッファを指す: "
+            << (reinterpret_cast<const std::byte*>(text->data()) >=
+                        storage.data() &&
+                    reinterpret_cast<const std::byte*>(text->data()) <
+                        storage.data() + storage.size()
+                ? "yes"
+                : "no")
+            << std::endl;
+
+  // 容量を超える書き込みは失敗として記録される
+  std::array<std::byte, 4> tiny{};
+  binary::BinaryWriter small(binary::SpanSink{tiny});
+  small.write(uint64_t{1});
+  std::cout << "4バイトに uint64_t を書く: ok=" << small.ok() << std::endl;
+
+  std::cout << std::endl;
+}
+
+void bounds_check_example() {
+  std::cout << "=== 境界チェック ===" << std::endl;
+
+  std::vector<std::byte> buffer;
+  binary::BinaryWriter writer(binary::VectorSink{buffer});
+  writer.write(std::string("truncated"));
+
+  // 末尾を切り詰めたデータを読む
+  binary::BinaryReader reader(
+      std::span<const std::byte>(buffer).first(buffer.size() - 3));
+  auto text = reader.read<std::string_view>();
+  std::cout << "切り詰めたデータ: " << (text ? "読めた" : "nullopt")
+            << ", ok=" << reader.ok() << std::endl;
+
+  // 長さフィールドが巨大な値でも確保は行わない
+  std::vector<std::byte> bogus(4, std::byte{0xFF});
+  binary::BinaryReader bogus_reader(bogus);
+  std::vector<float> values;
+  std::cout << "長さ 0xFFFFFFFF のベクタ: "
+            << (bogus_reader.read_vector(values) ? "読めた" : "失敗")
+            << ", capacity=" << values.capacity() << std::endl;
+
+  // bool は 0 / 1 以外のバイトを受け付けない
+  const std::byte flags[] = {std::byte{1}, std::byte{2}};
+  binary::BinaryReader flag_reader(flags);
+  auto first = flag_reader.read<bool>();
+  auto second = flag_reader.read<bool>();
+  std::cout << "bool のバイト 1, 2: "
+            << (first ? (*first ? "true" : "false") : "nullopt") << ", "
+            << (second ? "読めた" : "nullopt") << ", ok=" << flag_reader.ok()
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 4. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+double measure_ms(Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count();
+}
+
+void report(const char* label, double ms, size_t bytes, int rounds) {
+  double mb = static_cast<double>(bytes) * rounds / (1024.0 * 1024.0);
+  std::cout << label << ": " << ms << " ms (" << mb / (ms / 1000.0)
+            << " MB/s)" << std::endl;
+}
+
+void benchmark_example() {
+  constexpr size_t kPlayers = 100000;
+  constexpr int kRounds = 10;
+  std::cout << "=== ベンチマーク（" << kPlayers << " 人 x " << kRounds
+            << " 回のチェックポイント）===" << std::endl;
+
+  auto players = make_players(kPlayers);
+
+  std::vector<uint8_t> legacy_blob;
+  double legacy_ms = measure_ms([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      legacy_blob.clear();
+      for (const auto& p : players) {
+        legacy_write_player(legacy_blob, p);
+      }
+    }
+  });
+  report("serialize<T> + push_back     ", legacy_ms, legacy_blob.size(),
+         kRounds);
+
+  std::vector<std::byte> blob;
+  double vector_ms = measure_ms([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      blob.clear();  // 容量は再利用される
+      binary::BinaryWriter writer(binary::VectorSink{blob});
+      for (const auto& p : players) {
+        write_player(writer, p);
+      }
+    }
+  });
+  report("BinaryWriter<VectorSink>     ", vector_ms, blob.size(), kRounds);
+
+  std::vector<std::byte> fixed(blob.size());
+  size_t span_written = 0;
+  double span_ms = measure_ms([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      binary::BinaryWriter writer(binary::SpanSink{fixed});
+      for (const auto& p : players) {
+        write_player(writer, p);
+      }
+      span_written = writer.size();
+    }
+  });
+  report("BinaryWriter<SpanSink>       ", span_ms, span_written, kRounds);
+
+  bool same_bytes =
+      legacy_blob.size() == blob.size() &&
+      std::memcmp(legacy_blob.data(), blob.data(), blob.size()) == 0;
+  std::cout << "出力の一致: " << (same_bytes ? "OK" : "NG") << std::endl;
+
+  // 読み取り: 文字列はコピーしない
+  uint64_t checksum = 0;
+  bool read_ok = true;
+  double read_ms = measure_ms([&] {
+    std::vector<float> cooldowns;
+    for (int round = 0; round < kRounds; ++round) {
+      binary::BinaryReader reader(blob);
+      PlayerView view{};
+      while (reader.remaining() > 0) {
+        if (!read_player(reader, view, cooldowns)) {
+          read_ok = false;
+          break;
+        }
+        checksum += view.id + view.name.size();
+      }
+    }
+  });
+  report("BinaryReader (string_view)   ", read_ms, blob.size(), kRounds);
+  std::cout << "読み取り: " << (read_ok ? "OK" : "NG") << " (checksum "
+            << checksum << ")" << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "ゼロアロケーション・バイナリシリアライザのサンプル\n"
+            << std::endl;
+
+  basic_example();
+  bounds_check_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
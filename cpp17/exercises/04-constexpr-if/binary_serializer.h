@@ -0,0 +1,519 @@
+// ゼロアロケーションのバイナリシリアライザ / デシリアライザ
+// example.cpp の serialize<T> は値ごとに新しい std::vector を確保し、
+// 1バイトずつ push_back していた。ここでは
+//   - 書き込み先を呼び出し側が用意する（固定長の std::span か、再利用できる
+//     可変長バッファ）
+//   - trivially copyable な値と連続したレンジは memcpy で一括コピー
+//   - エンディアンは常にリトルエンディアンに固定
+//   - 読み取りは境界チェック付きで、文字列はコピーせずに元バッファを指す
+//     std::string_view で返す
+// という形に作り直す。型による分岐は元の serialize<T> と同じく
+// constexpr if で行う。
+//
+// 集成体はメンバ数をコンパイル時に検出し、構造化束縛で分解して
+// メンバごとに再帰的にシリアライズするので、構造体ごとの手書きコードは不要。
+// パディングのない trivially copyable な集成体は丸ごと memcpy する。
+//
+// std::span / std::endian / std::bit_cast を使うため C++20 でビルドする。
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace binary {
+
+// ============================================================================
+// 型の分類
+// ============================================================================
+
+// 整数・浮動小数点・列挙型（エンディアン変換の対象）
+template <typename T>
+inline constexpr bool is_scalar_v =
+    std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+// std::string / std::string_view
+template <typename T>
+inline constexpr bool is_string_v =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <typename T>
+struct is_vector : std::false_type {};
+
+template <typename T, typename Alloc>
+struct is_vector<std::vector<T, Alloc>> : std::true_type {};
+
+// data() と size() を持つ連続レンジ（std::vector, std::array, std::span など）
+template <typename T, typename = void>
+struct is_contiguous_range : std::false_type {};
+
+template <typename T>
+struct is_contiguous_range<
+    T, std::void_t<decltype(std::data(std::declval<const T&>())),
+                   decltype(std::size(std::declval<const T&>()))>>
+    : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_contiguous_range_v =
+    is_contiguous_range<T>::value && !is_string_v<T>;
+
+// パディングのない trivially copyable 型はそのままバイト列として扱える
+template <typename T>
+inline constexpr bool is_raw_copyable_v =
+    std::is_trivially_copyable_v<T> &&
+    std::has_unique_object_representations_v<T>;
+
+// ============================================================================
+// 集成体のメンバ数検出と分解
+// ============================================================================
+
+// 任意の型に変換できるダミー。T{any_field{}, ...} が何個まで通るかで
+// 集成体のメンバ数を調べる（未評価文脈でのみ使うので定義は不要）
+struct any_field {
+  template <typename U>
+  operator U() const;
+};
+
+template <typename T, typename Indices, typename = void>
+struct is_brace_constructible : std::false_type {};
+
+template <typename T, size_t... I>
+struct is_brace_constructible<
+    T, std::index_sequence<I...>,
+    std::void_t<decltype(T{(static_cast<void>(I), any_field{})...})>>
+    : std::true_type {};
+
+// 分解できるメンバ数の上限（for_each_field の分岐と合わせる）
+inline constexpr size_t kMaxAggregateFields = 12;
+
+// 初期化子が足りなくても集成体初期化は通るので、上限から順に試して
+// 最初に通った個数をメンバ数とする
+template <typename T, size_t N = kMaxAggregateFields>
+constexpr size_t aggregate_arity() {
+  if constexpr (N == 0) {
+    return 0;
+  } else if constexpr (is_brace_constructible<
+                           T, std::make_index_sequence<N>>::value) {
+    return N;
+  } else {
+    return aggregate_arity<T, N - 1>();
+  }
+}
+
+// 構造化束縛で集成体を分解し、全メンバをまとめて func(f0, f1, ...) に渡す
+// （Aggregate が const なら各メンバも const 参照になる）
+template <typename Aggregate, typename Func>
+decltype(auto) apply_fields(Aggregate& value, Func&& func) {
+  constexpr size_t kArity = aggregate_arity<std::remove_cv_t<Aggregate>>();
+  static_assert(kArity > 0 && kArity <= kMaxAggregateFields,
+                "メンバ数を検出できない集成体です");
+  if constexpr (kArity == 1) {
+    auto& [f0] = value;
+    return func(f0);
+  } else if constexpr (kArity == 2) {
+    auto& [f0, f1] = value;
+    return func(f0, f1);
+  } else if constexpr (kArity == 3) {
+    auto& [f0, f1, f2] = value;
+    return func(f0, f1, f2);
+  } else if constexpr (kArity == 4) {
+    auto& [f0, f1, f2, f3] = value;
+    return func(f0, f1, f2, f3);
+  } else if constexpr (kArity == 5) {
+    auto& [f0, f1, f2, f3, f4] = value;
+    return func(f0, f1, f2, f3, f4);
+  } else if constexpr (kArity == 6) {
+    auto& [f0, f1, f2, f3, f4, f5] = value;
+    return func(f0, f1, f2, f3, f4, f5);
+  } else if constexpr (kArity == 7) {
+    auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+    return func(f0, f1, f2, f3, f4, f5, f6);
+  } else if constexpr (kArity == 8) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+    return func(f0, f1, f2, f3, f4, f5, f6, f7);
+  } else if constexpr (kArity == 9) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+    return func(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+  } else if constexpr (kArity == 10) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+    return func(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+  } else if constexpr (kArity == 11) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+    return func(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+  } else if constexpr (kArity == 12) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+    return func(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+  }
+}
+
+// 各メンバに func を順に適用する
+template <typename Aggregate, typename Func>
+void for_each_field(Aggregate& value, Func&& func) {
+  apply_fields(value, [&func](auto&... fields) { (func(fields), ...); });
+}
+
+// どんなバイト列を読み込んでも正しい値になる型か。bool（0/1 以外は未定義動作）、
+// 列挙型、ポインタを含むものは、信用できない入力から丸ごと memcpy しない
+template <typename T>
+constexpr bool raw_readable() {
+  if constexpr (std::is_same_v<T, bool> || std::is_enum_v<T> ||
+                std::is_pointer_v<T>) {
+    return false;
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    return true;
+  } else if constexpr (std::is_array_v<T>) {
+    return raw_readable<std::remove_all_extents_t<T>>();
+  } else if constexpr (std::is_aggregate_v<T> &&
+                       aggregate_arity<T>() > 0 &&
+                       aggregate_arity<T>() <= kMaxAggregateFields) {
+    // メンバの型は分解した結果の型から調べる（未評価文脈なので値は作らない）
+    using Result = decltype(apply_fields(
+        std::declval<T&>(), [](auto&... fields) {
+          return std::bool_constant<(
+              raw_readable<std::remove_cvref_t<decltype(fields)>>() && ...)>{};
+        }));
+    return Result::value;
+  } else {
+    return false;
+  }
+}
+
+template <typename T>
+inline constexpr bool is_raw_readable_v = raw_readable<T>();
+
+// ============================================================================
+// エンディアン変換
+// ============================================================================
+
+template <typename U>
+constexpr U byteswap(U value) {
+  static_assert(std::is_unsigned_v<U>);
+  U result = 0;
+  for (size_t i = 0; i < sizeof(U); ++i) {
+    result = static_cast<U>((result << 8) | (value & 0xFF));
+    value = static_cast<U>(value >> 8);
+  }
+  return result;
+}
+
+// スカラー値と同じ大きさの符号なし整数
+template <typename T>
+using bits_t = std::conditional_t<
+    sizeof(T) == 1, uint8_t,
+    std::conditional_t<sizeof(T) == 2, uint16_t,
+                       std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+// ホストの表現 <-> リトルエンディアン表現
+template <typename T>
+constexpr bits_t<T> to_little_endian(T value) {
+  auto bits = std::bit_cast<bits_t<T>>(value);
+  if constexpr (std::endian::native == std::endian::big) {
+    bits = byteswap(bits);
+  }
+  return bits;
+}
+
+template <typename T>
+constexpr T from_little_endian(bits_t<T> bits) {
+  if constexpr (std::endian::native == std::endian::big) {
+    bits = byteswap(bits);
+  }
+  return std::bit_cast<T>(bits);
+}
+
+// ============================================================================
+// 書き込み先（Sink）
+// ============================================================================
+
+// 呼び出し側が用意した固定長バッファに書く。あふれたら以降の書き込みは失敗
+class SpanSink {
+ public:
+  explicit SpanSink(std::span<std::byte> buffer) : buffer_(buffer) {}
+
+  bool write(const void* data, size_t size) {
+    if (!ok_ || size > buffer_.size() - pos_) {
+      ok_ = false;
+      return false;
+    }
+    if (size != 0) {
+      std::memcpy(buffer_.data() + pos_, data, size);
+    }
+    pos_ += size;
+    return true;
+  }
+
+  void fail() { ok_ = false; }
+  bool ok() const { return ok_; }
+  size_t size() const { return pos_; }
+  std::span<const std::byte> written() const { return buffer_.first(pos_); }
+
+ private:
+  std::span<std::byte> buffer_;
+  size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+// 可変長バッファの末尾に追記する。clear() 後も容量が残るので、
+// 同じバッファを使い回せば定常状態ではヒープ確保が起きない
+class VectorSink {
+ public:
+  explicit VectorSink(std::vector<std::byte>& buffer) : buffer_(&buffer) {}
+
+  bool write(const void* data, size_t size) {
+    if (!ok_) {
+      return false;
+    }
+    const auto* bytes = static_cast<const std::byte*>(data);
+    buffer_->insert(buffer_->end(), bytes, bytes + size);
+    return true;
+  }
+
+  void fail() { ok_ = false; }
+  bool ok() const { return ok_; }
+  size_t size() const { return buffer_->size(); }
+  std::span<const std::byte> written() const { return *buffer_; }
+
+ private:
+  std::vector<std::byte>* buffer_;
+  bool ok_ = true;
+};
+
+// ============================================================================
+// BinaryWriter
+// ============================================================================
+
+// 文字列・レンジの長さは uint32_t（リトルエンディアン）で前置する
+using length_t = uint32_t;
+
+template <typename Sink>
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(Sink sink) : sink_(std::move(sink)) {}
+
+  template <typename T>
+  BinaryWriter& write(const T& value) {
+    if constexpr (is_scalar_v<T>) {
+      // スカラー: リトルエンディアンで書く（LE ホストでは単なる memcpy）
+      auto bits = to_little_endian(value);
+      sink_.write(&bits, sizeof(bits));
+    } else if constexpr (is_string_v<T>) {
+      // 文字列: 長さ + データ（一括コピー）
+      if (write_length(value.size())) {
+        sink_.write(value.data(), value.size());
+      }
+    } else if constexpr (is_contiguous_range_v<T>) {
+      // 連続レンジ: 要素数 + 要素
+      using Elem = std::remove_cv_t<
+          std::remove_reference_t<decltype(*std::data(value))>>;
+      if (!write_length(std::size(value))) {
+        return *this;
+      }
+      if constexpr (is_scalar_v<Elem> &&
+                    std::endian::native == std::endian::little &&
+                    is_raw_copyable_v<Elem>) {
+        // 高速経路: 要素の並びがそのままワイヤ形式になる
+        sink_.write(std::data(value), std::size(value) * sizeof(Elem));
+      } else {
+        for (const auto& elem : value) {
+          write(elem);
+        }
+      }
+    } else if constexpr (is_raw_copyable_v<T>) {
+      // パディングのない trivially copyable 型: バイト列として一括コピー
+      // （フィールドのエンディアン変換はしないので LE ホスト限定）
+      static_assert(std::endian::native == std::endian::little,
+                    "raw struct serialization requires a little-endian host");
+      sink_.write(&value, sizeof(T));
+    } else if constexpr (std::is_aggregate_v<T>) {
+      // それ以外の集成体: メンバごとに再帰的に書く
+      for_each_field(value, [this](const auto& field) { write(field); });
+    } else {
+      static_assert(!std::is_same_v<T, T>, "この型はシリアライズできません");
+    }
+    return *this;
+  }
+
+  BinaryWriter& write_bytes(const void* data, size_t size) {
+    sink_.write(data, size);
+    return *this;
+  }
+
+  bool ok() const { return sink_.ok(); }
+  size_t size() const { return sink_.size(); }
+  std::span<const std::byte> written() const { return sink_.written(); }
+
+ private:
+  bool write_length(size_t length) {
+    if (length > std::numeric_limits<length_t>::max()) {
+      // 長さが表現できない場合は書き込み失敗扱いにする
+      sink_.fail();
+      return false;
+    }
+    write(static_cast<length_t>(length));
+    return sink_.ok();
+  }
+
+  Sink sink_;
+};
+
+// ============================================================================
+// BinaryReader
+// ============================================================================
+
+// 境界チェック付きの読み取り。失敗すると std::nullopt を返し、
+// 以降の読み取りもすべて失敗する（ok() で確認できる）
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::span<const std::byte> data) : data_(data) {}
+
+  template <typename T>
+  std::optional<T> read() {
+    if constexpr (std::is_same_v<T, bool>) {
+      // 0 / 1 以外のバイトを bool に bit_cast すると未定義動作なので弾く
+      uint8_t byte;
+      if (!copy_out(&byte, 1)) {
+        return std::nullopt;
+      }
+      if (byte > 1) {
+        fail();
+        return std::nullopt;
+      }
+      return byte != 0;
+    } else if constexpr (is_scalar_v<T>) {
+      bits_t<T> bits;
+      if (!copy_out(&bits, sizeof(bits))) {
+        return std::nullopt;
+      }
+      return from_little_endian<T>(bits);
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+      // ゼロコピー: 元のバッファを指すビューを返す
+      auto bytes = read_prefixed_bytes();
+      if (!bytes) {
+        return std::nullopt;
+      }
+      return std::string_view(reinterpret_cast<const char*>(bytes->data()),
+                              bytes->size());
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      auto view = read<std::string_view>();
+      if (!view) {
+        return std::nullopt;
+      }
+      return std::string(*view);
+    } else if constexpr (is_raw_copyable_v<T> && is_raw_readable_v<T>) {
+      // bool や列挙型のメンバを含む集成体は下のメンバごとの経路で読む
+      static_assert(std::endian::native == std::endian::little,
+                    "raw struct deserialization requires a little-endian host");
+      T value;
+      if (!copy_out(&value, sizeof(T))) {
+        return std::nullopt;
+      }
+      return value;
+    } else if constexpr (is_vector<T>::value) {
+      T values;
+      if (!read_vector(values)) {
+        return std::nullopt;
+      }
+      return values;
+    } else if constexpr (std::is_aggregate_v<T>) {
+      // メンバごとに読む。途中で失敗したら残りのメンバは読まない
+      T value{};
+      for_each_field(value, [this](auto& field) {
+        using Field = std::remove_cv_t<std::remove_reference_t<decltype(field)>>;
+        if (ok_) {
+          if (auto parsed = read<Field>()) {
+            field = std::move(*parsed);
+          }
+        }
+      });
+      if (!ok_) {
+        return std::nullopt;
+      }
+      return value;
+    } else {
+      static_assert(!std::is_same_v<T, T>, "この型はデシリアライズできません");
+    }
+  }
+
+  // 要素数 + 要素の並びを読み、out に格納する（out の容量は再利用される）
+  template <typename T>
+  bool read_vector(std::vector<T>& out) {
+    auto count = read<length_t>();
+    if (!count) {
+      return false;
+    }
+    if constexpr (is_scalar_v<T> && std::endian::native == std::endian::little &&
+                  is_raw_copyable_v<T> && is_raw_readable_v<T>) {
+      // 要素数から必要なバイト数を先に検証してから確保する
+      if (*count > remaining() / sizeof(T)) {
+        return fail();
+      }
+      out.resize(*count);
+      return copy_out(out.data(), *count * sizeof(T));
+    } else {
+      out.clear();
+      for (length_t i = 0; i < *count; ++i) {
+        auto elem = read<T>();
+        if (!elem) {
+          return false;
+        }
+        out.push_back(std::move(*elem));
+      }
+      return true;
+    }
+  }
+
+  // n バイトをそのまま返す（コピーなし）
+  std::optional<std::span<const std::byte>> read_bytes(size_t size) {
+    if (!ok_ || size > remaining()) {
+      fail();
+      return std::nullopt;
+    }
+    auto bytes = data_.subspan(pos_, size);
+    pos_ += size;
+    return bytes;
+  }
+
+  bool ok() const { return ok_; }
+  size_t position() const { return pos_; }
+  size_t remaining() const { return data_.size() - pos_; }
+
+ private:
+  bool fail() {
+    ok_ = false;
+    return false;
+  }
+
+  bool copy_out(void* out, size_t size) {
+    auto bytes = read_bytes(size);
+    if (!bytes) {
+      return false;
+    }
+    std::memcpy(out, bytes->data(), size);
+    return true;
+  }
+
+  std::optional<std::span<const std::byte>> read_prefixed_bytes() {
+    auto length = read<length_t>();
+    if (!length) {
+      return std::nullopt;
+    }
+    return read_bytes(*length);
+  }
+
+  std::span<const std::byte> data_;
+  size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+}  // namespace binary
@@ -0,0 +1,247 @@
+// integer_codec.h のサンプルとベンチマーク
+//   - varint / zigzag の基本
+//   - プレイヤー ID 列（昇順）とスコア列（小さな値が中心、負の値あり）で
+//     固定長・varint・差分 + varint・Stream VByte のサイズとデコード速度を比較
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "integer_codec.h"
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== varint と zigzag ===" << std::endl;
+
+  for (int32_t value : {0, -1, 1, 63, -64, 300, -100000}) {
+    std::vector<std::byte> buffer;
+    binary::BinaryWriter writer(binary::VectorSink{buffer});
+    binary::write_varint(writer, value);
+    binary::BinaryReader reader(buffer);
+    auto back = binary::read_varint<int32_t>(reader);
+    std::cout << std::setw(8) << value << " -> zigzag "
+              << std::setw(6) << binary::zigzag_encode(value) << ", "
+              << buffer.size() << " バイト, 復元 " << *back << std::endl;
+  }
+
+  // 継続フラグが立ったまま終わるデータ
+  std::vector<std::byte> broken{std::byte{0x80}, std::byte{0x80}};
+  binary::BinaryReader reader(broken);
+  std::cout << "途中で切れた varint: "
+            << (binary::read_varint<uint32_t>(reader) ? "読めた" : "nullopt")
+            << std::endl;
+
+  // 10 バイト目に bit 63 より上のビットがあるデータ（uint64_t に収まらない）
+  std::vector<std::byte> too_wide(9, std::byte{0xFF});
+  too_wide.push_back(std::byte{0x02});
+  binary::BinaryReader wide_reader(too_wide);
+  std::cout << "64 ビットを超える varint: "
+            << (binary::read_varint<uint64_t>(wide_reader) ? "読めた" : "nullopt")
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. ベンチマーク用の列
+// ============================================================================
+
+struct Columns {
+  std::vector<uint32_t> player_ids;  // 昇順、間隔は 1〜20
+  std::vector<int32_t> scores;       // 大半は 0〜1000、たまに大きい/負の値
+};
+
+Columns make_columns(size_t count) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint32_t> gap(1, 20);
+  std::geometric_distribution<int32_t> small(0.01);
+  std::uniform_int_distribution<int> rare(0, 99);
+
+  Columns columns;
+  columns.player_ids.reserve(count);
+  columns.scores.reserve(count);
+  uint32_t id = 1000000;
+  for (size_t i = 0; i < count; ++i) {
+    id += gap(rng);
+    columns.player_ids.push_back(id);
+    int32_t score = small(rng);
+    int roll = rare(rng);
+    if (roll < 3) {
+      score = -score;  // ペナルティ
+    } else if (roll < 5) {
+      score *= 1000;  // ボーナス
+    }
+    columns.scores.push_back(score);
+  }
+  return columns;
+}
+
+std::vector<uint32_t> zigzag_column(const std::vector<int32_t>& values) {
+  std::vector<uint32_t> out;
+  out.reserve(values.size());
+  for (int32_t value : values) {
+    out.push_back(binary::zigzag_encode(value));
+  }
+  return out;
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+double measure_ms(Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count();
+}
+
+constexpr int kRounds = 20;
+
+// 1列分のエンコード結果を受け取り、デコードを kRounds 回計測して表示する
+template <typename Decode>
+void report(const char* label, const std::vector<std::byte>& encoded,
+            size_t count, const std::vector<uint32_t>& expected,
+            Decode&& decode) {
+  std::vector<uint32_t> decoded;
+  bool ok = true;
+  double ms = measure_ms([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      binary::BinaryReader reader(encoded);
+      ok = decode(reader, decoded) && ok;
+    }
+  });
+  ok = ok && decoded == expected;
+  double values_per_sec = static_cast<double>(count) * kRounds / (ms / 1000.0);
+  std::cout << "  " << std::left << std::setw(26) << label << std::right
+            << std::setw(10) << encoded.size() << " バイト ("
+            << std::fixed << std::setprecision(2)
+            << static_cast<double>(encoded.size()) / static_cast<double>(count)
+            << " B/値), デコード " << std::setprecision(0)
+            << values_per_sec / 1e6 << " M値/s " << (ok ? "OK" : "NG")
+            << std::defaultfloat << std::endl;
+}
+
+template <typename Encode>
+std::vector<std::byte> encode(Encode&& encode_column) {
+  std::vector<std::byte> buffer;
+  binary::BinaryWriter writer(binary::VectorSink{buffer});
+  encode_column(writer);
+  return buffer;
+}
+
+using Writer = binary::BinaryWriter<binary::VectorSink>;
+
+void benchmark_ids(const std::vector<uint32_t>& ids) {
+  std::cout << "プレイヤー ID 列:" << std::endl;
+
+  report("固定長 uint32", encode([&](Writer& w) { w.write(ids); }), ids.size(),
+         ids, [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           return r.read_vector(out);
+         });
+
+  report("差分 + varint",
+         encode([&](Writer& w) { binary::write_delta_varint_column(w, ids); }),
+         ids.size(), ids,
+         [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           return binary::read_delta_varint_column(r, out);
+         });
+
+  auto delta_vbyte = encode(
+      [&](Writer& w) { binary::write_stream_vbyte<true>(w, ids); });
+  report("差分 + Stream VByte (scalar)", delta_vbyte, ids.size(), ids,
+         [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           return binary::read_stream_vbyte<true>(r, out, false);
+         });
+  report("差分 + Stream VByte (SSSE3)", delta_vbyte, ids.size(), ids,
+         [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           return binary::read_stream_vbyte<true>(r, out, true);
+         });
+}
+
+void benchmark_scores(const std::vector<int32_t>& scores) {
+  std::cout << "スコア列（zigzag 済みの値で照合）:" << std::endl;
+
+  auto expected = zigzag_column(scores);
+
+  report("固定長 int32", encode([&](Writer& w) { w.write(scores); }),
+         scores.size(), expected,
+         [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           std::vector<int32_t> raw;
+           if (!r.read_vector(raw)) {
+             return false;
+           }
+           out = zigzag_column(raw);
+           return true;
+         });
+
+  report("zigzag + varint",
+         encode([&](Writer& w) {
+           binary::write_varint(w, static_cast<uint64_t>(scores.size()));
+           for (int32_t score : scores) {
+             binary::write_varint(w, score);
+           }
+         }),
+         scores.size(), expected,
+         [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           auto count = binary::read_varint<uint64_t>(r);
+           if (!count || *count > r.remaining()) {
+             return false;
+           }
+           out.resize(static_cast<size_t>(*count));
+           for (auto& value : out) {
+             auto score = binary::read_varint<int32_t>(r);
+             if (!score) {
+               return false;
+             }
+             value = binary::zigzag_encode(*score);
+           }
+           return true;
+         });
+
+  auto vbyte = encode(
+      [&](Writer& w) { binary::write_stream_vbyte(w, expected); });
+  report("zigzag + Stream VByte (scalar)", vbyte, scores.size(), expected,
+         [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           return binary::read_stream_vbyte(r, out, false);
+         });
+  report("zigzag + Stream VByte (SSSE3)", vbyte, scores.size(), expected,
+         [](binary::BinaryReader& r, std::vector<uint32_t>& out) {
+           return binary::read_stream_vbyte(r, out, true);
+         });
+}
+
+void benchmark_example() {
+  constexpr size_t kCount = 1000000;
+  std::cout << "=== ベンチマーク（" << kCount << " 行, デコード " << kRounds
+            << " 回）===" << std::endl;
+
+  auto columns = make_columns(kCount);
+  benchmark_ids(columns.player_ids);
+  benchmark_scores(columns.scores);
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "整数列のコンパクトなエンコーディングのサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
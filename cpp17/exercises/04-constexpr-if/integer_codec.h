@@ -0,0 +1,350 @@
+// 整数列のコンパクトなエンコーディング
+// binary_serializer.h の BinaryWriter / BinaryReader の上に
+//   - LEB128 varint（7ビットずつ、最上位ビットが継続フラグ）
+//   - zigzag（符号付き整数を小さな絶対値ほど小さな符号なし整数へ）
+//   - 差分 + varint（昇順に並んだ ID 列向け）
+//   - Stream VByte（2ビットの長さコードを制御バイトにまとめ、
+//     デコードを SSSE3 の pshufb で4値ずつ行う）
+// を用意する。符号付き/符号なしの分岐は constexpr if で行う。
+//
+// SIMD デコードは x86-64 の GCC/Clang で target 属性を使ってコンパイルし、
+// 実行時に CPU が SSSE3 を持つときだけ使う（それ以外はスカラー版）。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "binary_serializer.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define INTEGER_CODEC_HAS_SSSE3 1
+#include <immintrin.h>
+#endif
+
+namespace binary {
+
+// ============================================================================
+// zigzag
+// ============================================================================
+
+// 0, -1, 1, -2, 2, ... -> 0, 1, 2, 3, 4, ...
+template <typename T>
+constexpr std::make_unsigned_t<T> zigzag_encode(T value) {
+  using U = std::make_unsigned_t<T>;
+  if constexpr (std::is_signed_v<T>) {
+    return static_cast<U>((static_cast<U>(value) << 1) ^
+                          static_cast<U>(value >> (sizeof(T) * 8 - 1)));
+  } else {
+    return value;
+  }
+}
+
+template <typename T>
+constexpr T zigzag_decode(std::make_unsigned_t<T> value) {
+  if constexpr (std::is_signed_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(value >> 1) ^
+                          static_cast<U>(-static_cast<T>(value & 1)));
+  } else {
+    return value;
+  }
+}
+
+static_assert(zigzag_encode(int32_t{0}) == 0u);
+static_assert(zigzag_encode(int32_t{-1}) == 1u);
+static_assert(zigzag_encode(int32_t{1}) == 2u);
+static_assert(zigzag_decode<int32_t>(zigzag_encode(int32_t{-123456})) ==
+              -123456);
+
+// ============================================================================
+// LEB128 varint
+// ============================================================================
+
+// uint64_t は最大 10 バイト
+inline constexpr size_t kMaxVarintBytes = 10;
+
+// value を out に書き、使ったバイト数を返す
+inline size_t encode_varint(uint64_t value, uint8_t* out) {
+  size_t size = 0;
+  while (value >= 0x80) {
+    out[size++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[size++] = static_cast<uint8_t>(value);
+  return size;
+}
+
+// 符号付き整数は zigzag してから書く
+template <typename Sink, typename T>
+void write_varint(BinaryWriter<Sink>& writer, T value) {
+  static_assert(std::is_integral_v<T>, "varint は整数型のみ");
+  uint8_t bytes[kMaxVarintBytes];
+  size_t size = encode_varint(static_cast<uint64_t>(zigzag_encode(value)),
+                              bytes);
+  writer.write_bytes(bytes, size);
+}
+
+// 途中で切れている、10 バイトを超える、64 ビットを超える、T に収まらない場合は nullopt
+template <typename T>
+std::optional<T> read_varint(BinaryReader& reader) {
+  static_assert(std::is_integral_v<T>, "varint は整数型のみ");
+  using U = std::make_unsigned_t<T>;
+  uint64_t result = 0;
+  for (size_t i = 0; i < kMaxVarintBytes; ++i) {
+    auto byte = reader.read<uint8_t>();
+    if (!byte) {
+      return std::nullopt;
+    }
+    // 10 バイト目に残っているのは bit 63 の1ビットだけ。それより上の
+    // ビットや継続フラグが立っていれば、黙って切り捨てずに不正とする
+    if (i == kMaxVarintBytes - 1 && *byte > 1) {
+      return std::nullopt;
+    }
+    result |= static_cast<uint64_t>(*byte & 0x7F) << (7 * i);
+    if ((*byte & 0x80) == 0) {
+      if (result > std::numeric_limits<U>::max()) {
+        return std::nullopt;
+      }
+      return zigzag_decode<T>(static_cast<U>(result));
+    }
+  }
+  return std::nullopt;
+}
+
+// ============================================================================
+// 差分 + varint（昇順の ID 列）
+// ============================================================================
+
+// 要素数、先頭の値、隣との差分を varint で書く。
+// values は昇順であること（差分が負になると巨大な値として書かれる）
+template <typename Sink>
+void write_delta_varint_column(BinaryWriter<Sink>& writer,
+                               std::span<const uint32_t> values) {
+  write_varint(writer, static_cast<uint64_t>(values.size()));
+  uint32_t previous = 0;
+  for (uint32_t value : values) {
+    write_varint(writer, value - previous);
+    previous = value;
+  }
+}
+
+inline bool read_delta_varint_column(BinaryReader& reader,
+                                     std::vector<uint32_t>& out) {
+  auto count = read_varint<uint64_t>(reader);
+  // 1要素は最低 1 バイトなので、残りバイト数より多い要素数は不正
+  if (!count || *count > reader.remaining()) {
+    return false;
+  }
+  out.resize(static_cast<size_t>(*count));
+  uint32_t previous = 0;
+  for (auto& value : out) {
+    auto delta = read_varint<uint32_t>(reader);
+    if (!delta) {
+      return false;
+    }
+    previous += *delta;
+    value = previous;
+  }
+  return true;
+}
+
+// ============================================================================
+// Stream VByte
+// ============================================================================
+//
+// レイアウト: [要素数 uint32][制御バイト (n+3)/4 個][データ]
+// 制御バイトは4値分の長さコード（長さ-1、2ビットずつ下位から）を持ち、
+// データは各値の下位 1〜4 バイトをリトルエンディアンで詰めたもの。
+
+namespace detail {
+
+constexpr size_t vbyte_length(uint32_t value) {
+  return value < (1u << 8)    ? 1
+         : value < (1u << 16) ? 2
+         : value < (1u << 24) ? 3
+                              : 4;
+}
+
+// 制御バイト -> 4値分のデータバイト数
+constexpr std::array<uint8_t, 256> make_vbyte_group_lengths() {
+  std::array<uint8_t, 256> table{};
+  for (size_t control = 0; control < 256; ++control) {
+    size_t total = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      total += ((control >> (2 * i)) & 3) + 1;
+    }
+    table[control] = static_cast<uint8_t>(total);
+  }
+  return table;
+}
+
+// 制御バイト -> pshufb のシャッフルマスク（0x80 の位置は 0 になる）
+constexpr std::array<std::array<uint8_t, 16>, 256> make_vbyte_shuffles() {
+  std::array<std::array<uint8_t, 16>, 256> table{};
+  for (size_t control = 0; control < 256; ++control) {
+    uint8_t source = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      size_t length = ((control >> (2 * i)) & 3) + 1;
+      for (size_t b = 0; b < 4; ++b) {
+        table[control][i * 4 + b] =
+            b < length ? static_cast<uint8_t>(source + b) : uint8_t{0x80};
+      }
+      source = static_cast<uint8_t>(source + length);
+    }
+  }
+  return table;
+}
+
+inline constexpr auto kVbyteGroupLengths = make_vbyte_group_lengths();
+alignas(16) inline constexpr auto kVbyteShuffles = make_vbyte_shuffles();
+
+inline uint32_t load_vbyte(const std::byte* data, size_t length) {
+  uint8_t bytes[4] = {0, 0, 0, 0};
+  std::memcpy(bytes, data, length);
+  return static_cast<uint32_t>(bytes[0]) |
+         (static_cast<uint32_t>(bytes[1]) << 8) |
+         (static_cast<uint32_t>(bytes[2]) << 16) |
+         (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+// 先頭 count 個分のデータバイト数
+inline size_t vbyte_data_length(std::span<const std::byte> control,
+                                size_t count) {
+  size_t total = 0;
+  size_t full_groups = count / 4;
+  for (size_t g = 0; g < full_groups; ++g) {
+    total += kVbyteGroupLengths[std::to_integer<uint8_t>(control[g])];
+  }
+  for (size_t i = full_groups * 4; i < count; ++i) {
+    auto code = std::to_integer<uint8_t>(control[i / 4]) >> (2 * (i % 4));
+    total += (code & 3) + 1;
+  }
+  return total;
+}
+
+// スカラー版。first 番目から count - 1 番目までを復号する
+inline void vbyte_decode_scalar(std::span<const std::byte> control,
+                                const std::byte* data, size_t first,
+                                size_t count, uint32_t* out) {
+  for (size_t i = first; i < count; ++i) {
+    auto code = std::to_integer<uint8_t>(control[i / 4]) >> (2 * (i % 4));
+    size_t length = (code & 3) + 1;
+    out[i] = load_vbyte(data, length);
+    data += length;
+  }
+}
+
+#if defined(INTEGER_CODEC_HAS_SSSE3)
+
+// SSSE3 版。16 バイト読みがデータ末尾を越えない範囲で4値ずつ復号し、
+// 残りはスカラー版に任せる
+__attribute__((target("ssse3"))) inline void vbyte_decode_ssse3(
+    std::span<const std::byte> control, const std::byte* data,
+    const std::byte* data_end, size_t count, uint32_t* out) {
+  size_t full_groups = count / 4;
+  size_t g = 0;
+  for (; g < full_groups && data_end - data >= 16; ++g) {
+    uint8_t code = std::to_integer<uint8_t>(control[g]);
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i shuffle = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(kVbyteShuffles[code].data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + g * 4),
+                     _mm_shuffle_epi8(bytes, shuffle));
+    data += kVbyteGroupLengths[code];
+  }
+  vbyte_decode_scalar(control, data, g * 4, count, out);
+}
+
+inline bool cpu_has_ssse3() {
+  static const bool supported = __builtin_cpu_supports("ssse3");
+  return supported;
+}
+
+#endif
+
+}  // namespace detail
+
+// values の各要素（kDelta なら直前との差分）を Stream VByte で書く
+template <bool kDelta = false, typename Sink>
+void write_stream_vbyte(BinaryWriter<Sink>& writer,
+                        std::span<const uint32_t> values) {
+  writer.write(static_cast<length_t>(values.size()));
+
+  auto encoded = [&](size_t i) {
+    if constexpr (kDelta) {
+      return values[i] - (i == 0 ? 0u : values[i - 1]);
+    } else {
+      return values[i];
+    }
+  };
+
+  // 1パス目: 制御バイト
+  for (size_t base = 0; base < values.size(); base += 4) {
+    uint8_t control = 0;
+    for (size_t i = base; i < base + 4 && i < values.size(); ++i) {
+      auto code = static_cast<uint8_t>(detail::vbyte_length(encoded(i)) - 1);
+      control = static_cast<uint8_t>(control | (code << (2 * (i - base))));
+    }
+    writer.write(control);
+  }
+
+  // 2パス目: データ（下位バイトから必要な分だけ）
+  for (size_t i = 0; i < values.size(); ++i) {
+    uint32_t value = encoded(i);
+    uint8_t bytes[4] = {static_cast<uint8_t>(value),
+                        static_cast<uint8_t>(value >> 8),
+                        static_cast<uint8_t>(value >> 16),
+                        static_cast<uint8_t>(value >> 24)};
+    writer.write_bytes(bytes, detail::vbyte_length(value));
+  }
+}
+
+// use_simd が false のときはスカラー版で復号する（ベンチマーク用）
+template <bool kDelta = false>
+bool read_stream_vbyte(BinaryReader& reader, std::vector<uint32_t>& out,
+                       bool use_simd = true) {
+  auto count = reader.read<length_t>();
+  if (!count) {
+    return false;
+  }
+  auto control = reader.read_bytes((static_cast<size_t>(*count) + 3) / 4);
+  if (!control) {
+    return false;
+  }
+  auto data = reader.read_bytes(detail::vbyte_data_length(*control, *count));
+  if (!data) {
+    return false;
+  }
+
+  out.resize(*count);
+#if defined(INTEGER_CODEC_HAS_SSSE3)
+  if (use_simd && detail::cpu_has_ssse3()) {
+    detail::vbyte_decode_ssse3(*control, data->data(),
+                               data->data() + data->size(), *count, out.data());
+  } else {
+    detail::vbyte_decode_scalar(*control, data->data(), 0, *count, out.data());
+  }
+#else
+  static_cast<void>(use_simd);
+  detail::vbyte_decode_scalar(*control, data->data(), 0, *count, out.data());
+#endif
+
+  if constexpr (kDelta) {
+    uint32_t running = 0;
+    for (auto& value : out) {
+      running += value;
+      value = running;
+    }
+  }
+  return true;
+}
+
+}  // namespace binary
@@ -0,0 +1,125 @@
+// parallel_invoke.h のサンプルとベンチマーク
+//   - parallel_apply_to_all / parallel_invoke の基本
+//   - 例外の伝播
+//   - フレームごとの独立したサブシステムを順番に / 並列に実行した比較
+//   - 小さな仕事での Grain によるインライン実行
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "parallel_invoke.h"
+
+// ============================================================================
+// 1. 比較用: example.cpp と同じ順次実行
+// ============================================================================
+
+template <typename Func, typename... Args>
+void apply_to_all(Func func, Args... args) {
+  (func(args), ...);
+}
+
+// ============================================================================
+// 2. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== parallel_apply_to_all ===" << std::endl;
+  std::cout << "ワーカー数: " << parallel::ThreadPool::instance().worker_count()
+            << "（+ 呼び出し元）" << std::endl;
+
+  std::atomic<int> sum{0};
+  parallel::parallel_apply_to_all([&](int x) { sum += x * 2; }, 1, 2, 3, 4, 5);
+  std::cout << "各要素を2倍した合計: " << sum << std::endl;
+
+  int physics = 0;
+  int audio = 0;
+  int ai = 0;
+  parallel::parallel_invoke([&] { physics = 1; }, [&] { audio = 2; },
+                            [&] { ai = 3; });
+  std::cout << "physics=" << physics << ", audio=" << audio << ", ai=" << ai
+            << std::endl;
+
+  try {
+    parallel::parallel_invoke([] {},
+                              [] { throw std::runtime_error("AI が失敗"); },
+                              [] {});
+  } catch (const std::exception& e) {
+    std::cout << "例外を受け取った: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+// 約 cost_us マイクロ秒の計算をする「サブシステム」
+double simulate(int cost_us) {
+  double acc = 0.0;
+  int iterations = cost_us * 50;
+  for (int i = 0; i < iterations; ++i) {
+    acc += std::sqrt(static_cast<double>(i) + acc * 1e-9);
+  }
+  return acc;
+}
+
+template <typename Func>
+double measure_us(int frames, Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < frames; ++frame) {
+    func();
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count() / frames;
+}
+
+void benchmark_frame(int cost_us, int frames) {
+  double results[6] = {};
+  auto subsystem = [&](int index) { results[index] += simulate(cost_us); };
+
+  double sequential = measure_us(frames, [&] {
+    apply_to_all(subsystem, 0, 1, 2, 3, 4, 5);
+  });
+  double parallel = measure_us(frames, [&] {
+    parallel::parallel_apply_to_all(subsystem, 0, 1, 2, 3, 4, 5);
+  });
+  double with_grain = measure_us(frames, [&] {
+    parallel::parallel_apply_to_all(
+        parallel::Grain{std::chrono::microseconds(cost_us)}, subsystem, 0, 1,
+        2, 3, 4, 5);
+  });
+
+  std::cout << "6 サブシステム x 約 " << cost_us << " us: 順次 " << sequential
+            << " us, 並列 " << parallel << " us, Grain 指定 " << with_grain
+            << " us / フレーム (checksum " << results[0] << ")" << std::endl;
+}
+
+void benchmark_example() {
+  std::cout << "=== ベンチマーク（1フレームあたりの時間）===" << std::endl;
+
+  benchmark_frame(500, 200);  // 大きな仕事: 並列化が効く
+  benchmark_frame(50, 2000);
+  benchmark_frame(1, 20000);  // 小さな仕事: Grain でインライン実行
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "parallel_invoke のサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
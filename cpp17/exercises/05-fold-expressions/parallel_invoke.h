@@ -0,0 +1,250 @@
+// parallel_invoke / parallel_apply_to_all
+// example.cpp の apply_to_all(func, args...) は (func(args), ...) で
+// 順番に呼ぶ。互いに独立な呼び出しなら
+//   - 最後の1つ以外をスレッドプールに投入し
+//   - 最後の1つは呼び出し元のスレッドで実行し
+//   - std::latch で全部の完了を待つ（待つ間はキューに残った仕事を手伝う）
+// ことで重ねて実行できる。呼び出しごとにスレッドは作らず、仕事は
+// 関数ポインタ + 呼び出し元スタック上のオブジェクトへのポインタとして
+// 渡すのでヒープ確保もしない。
+//
+// 1つあたりの見積もりコストが小さい場合は、投入と待ち合わせのほうが高く
+// つくので、その場で順番に実行する（Grain）。
+//
+// std::latch を使うため C++20 でビルドする。
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parallel {
+
+// ============================================================================
+// ThreadPool
+// ============================================================================
+
+class ThreadPool {
+ public:
+  // ヒープ確保を避けるため、仕事は関数ポインタと引数ポインタの組で表す
+  struct Task {
+    void (*run)(void*);
+    void* context;
+  };
+
+  explicit ThreadPool(size_t worker_count) {
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // 呼び出し元も1つ実行するので、ワーカーはコア数 - 1
+  static ThreadPool& instance() {
+    static ThreadPool pool(
+        std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1);
+    return pool;
+  }
+
+  // まとめて投入してロックと通知を1回で済ませる
+  void submit(const Task* tasks, size_t count) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.insert(queue_.end(), tasks, tasks + count);
+    }
+    if (count == 1) {
+      ready_.notify_one();
+    } else {
+      ready_.notify_all();
+    }
+  }
+
+  // キューに仕事があれば呼び出し元のスレッドで1つ実行する
+  bool try_run_one() {
+    Task task;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.empty()) {
+        return false;
+      }
+      task = queue_.front();
+      queue_.pop_front();
+    }
+    task.run(task.context);
+    return true;
+  }
+
+  size_t worker_count() const { return workers_.size(); }
+
+ private:
+  void worker_loop() {
+    for (;;) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+          return;  // stopping_ かつ仕事が残っていない
+        }
+        task = queue_.front();
+        queue_.pop_front();
+      }
+      task.run(task.context);
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<Task> queue_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+// ============================================================================
+// 粒度
+// ============================================================================
+
+// 1呼び出しあたりの見積もりコスト。cutoff 未満ならその場で順番に実行する
+struct Grain {
+  std::chrono::nanoseconds estimated_cost;
+};
+
+// 投入 + 起床 + 待ち合わせのおおよそのコストの数倍
+inline constexpr std::chrono::nanoseconds kInlineCutoff =
+    std::chrono::microseconds(20);
+
+namespace detail {
+
+// 全呼び出しの完了と、最初に投げられた例外を記録する
+class Completion {
+ public:
+  explicit Completion(std::ptrdiff_t count) : latch_(count) {}
+
+  template <typename Func>
+  void run(Func& func) noexcept {
+    try {
+      func();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+    latch_.count_down();
+  }
+
+  // 待つ間はプールのキューを手伝う（入れ子の呼び出しでも詰まらない）
+  void wait(ThreadPool& pool) {
+    while (!latch_.try_wait()) {
+      if (!pool.try_run_one()) {
+        latch_.wait();
+        break;
+      }
+    }
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ private:
+  std::latch latch_;
+  std::mutex mutex_;
+  std::exception_ptr error_;
+};
+
+template <typename Func>
+struct Job {
+  Func* func;
+  Completion* completion;
+
+  static void run(void* self) {
+    auto* job = static_cast<Job*>(self);
+    job->completion->run(*job->func);
+  }
+};
+
+template <typename Tuple, size_t... I>
+void fan_out(ThreadPool& pool, Tuple& jobs, std::index_sequence<I...>) {
+  // 最後の1つ（インデックス sizeof...(I)）は呼び出し元が実行する
+  ThreadPool::Task tasks[] = {
+      {&std::tuple_element_t<I, Tuple>::run, &std::get<I>(jobs)}...};
+  pool.submit(tasks, sizeof...(I));
+}
+
+}  // namespace detail
+
+// ============================================================================
+// parallel_invoke / parallel_apply_to_all
+// ============================================================================
+
+// funcs... を並列に実行し、すべて終わるまで待つ。
+// 例外が投げられた場合は全部の完了を待ってから最初の1つを投げ直す
+template <typename... Funcs>
+void parallel_invoke(ThreadPool& pool, Funcs&&... funcs) {
+  if constexpr (sizeof...(Funcs) == 1) {
+    (funcs(), ...);
+  } else if constexpr (sizeof...(Funcs) > 1) {
+    detail::Completion completion(sizeof...(Funcs));
+    std::tuple<detail::Job<std::remove_reference_t<Funcs>>...> jobs{
+        detail::Job<std::remove_reference_t<Funcs>>{&funcs, &completion}...};
+
+    detail::fan_out(pool, jobs,
+                    std::make_index_sequence<sizeof...(Funcs) - 1>{});
+    auto& last = std::get<sizeof...(Funcs) - 1>(jobs);
+    completion.run(*last.func);
+    completion.wait(pool);
+  }
+}
+
+template <typename... Funcs>
+void parallel_invoke(Funcs&&... funcs) {
+  parallel_invoke(ThreadPool::instance(), std::forward<Funcs>(funcs)...);
+}
+
+// 見積もりコストが小さければその場で順番に実行する
+template <typename... Funcs>
+void parallel_invoke(Grain grain, Funcs&&... funcs) {
+  if (grain.estimated_cost < kInlineCutoff) {
+    (funcs(), ...);
+  } else {
+    parallel_invoke(ThreadPool::instance(), std::forward<Funcs>(funcs)...);
+  }
+}
+
+// apply_to_all(func, args...) の並列版
+template <typename Func, typename... Args>
+void parallel_apply_to_all(Func func, Args... args) {
+  parallel_invoke([&func, &args] { func(args); }...);
+}
+
+template <typename Func, typename... Args>
+void parallel_apply_to_all(Grain grain, Func func, Args... args) {
+  parallel_invoke(grain, [&func, &args] { func(args); }...);
+}
+
+}  // namespace parallel
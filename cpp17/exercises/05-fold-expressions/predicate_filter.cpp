@@ -0,0 +1,160 @@
+// predicate_filter.h のサンプルとベンチマーク
+//   - ビットマスクと選択ベクタ
+//   - 1値ずつ all_predicates を呼ぶ方式との比較（2000 万行 x 3 述語）
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "predicate_filter.h"
+
+// ============================================================================
+// 1. 比較用: solution.cpp と同じ1値ずつの判定
+// ============================================================================
+
+template <typename T, typename... Predicates>
+bool all_predicates(T value, Predicates... predicates) {
+  return (predicates(value) && ...);
+}
+
+template <typename T, typename... Predicates>
+bool any_predicate(T value, Predicates... predicates) {
+  return (predicates(value) || ...);
+}
+
+// ============================================================================
+// 2. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== ビットマスクと選択ベクタ ===" << std::endl;
+
+  std::vector<int> values;
+  for (int i = -10; i < 90; ++i) {
+    values.push_back(i);
+  }
+
+  auto is_positive = [](int x) { return x > 0; };
+  auto is_even = [](int x) { return x % 2 == 0; };
+  auto is_less_than_20 = [](int x) { return x < 20; };
+
+  std::vector<uint64_t> words;
+  filter::bitmask_all(std::span<const int>(values), words, is_positive, is_even,
+                      is_less_than_20);
+  std::cout << "ワード数: " << words.size() << ", 先頭ワード: 0x" << std::hex
+            << words[0] << std::dec << std::endl;
+
+  std::vector<uint32_t> rows;
+  filter::to_selection(words, rows);
+  std::cout << "正かつ偶数かつ 20 未満: ";
+  for (uint32_t row : rows) {
+    std::cout << values[row] << " ";
+  }
+  std::cout << std::endl;
+
+  filter::select_any(std::span<const int>(values), rows,
+                     [](int x) { return x < -8; }, [](int x) { return x > 87; });
+  std::cout << "-8 未満または 87 より大きい: ";
+  for (uint32_t row : rows) {
+    std::cout << values[row] << " ";
+  }
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+double measure_ms(Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count();
+}
+
+void benchmark_example() {
+  constexpr size_t kRows = 20000000;
+  std::cout << "=== ベンチマーク（" << kRows << " 行）===" << std::endl;
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int32_t> dist(0, 999999);
+  std::vector<int32_t> column(kRows);
+  for (auto& value : column) {
+    value = dist(rng);
+  }
+  std::span<const int32_t> view(column);
+
+  auto at_least = [](int32_t x) { return x >= 100000; };
+  auto below = [](int32_t x) { return x < 900000; };
+  auto low_bits = [](int32_t x) { return (x & 7) == 0; };
+  auto rare = [](int32_t x) { return x < 1000; };
+
+  std::vector<uint32_t> expected;
+  std::vector<uint32_t> rows;
+
+  auto run = [&](const char* label, auto&& scalar, auto&& vectorized) {
+    expected.clear();
+    double scalar_ms = measure_ms([&] { scalar(); });
+    double vector_ms = measure_ms([&] { vectorized(); });
+    std::cout << label << ": 1値ずつ " << scalar_ms << " ms, ビットマスク "
+              << vector_ms << " ms (" << scalar_ms / vector_ms << " 倍), "
+              << rows.size() << " 行 " << (rows == expected ? "OK" : "NG")
+              << std::endl;
+  };
+
+  run(
+      "AND 3述語（選択率 10%）",
+      [&] {
+        for (size_t i = 0; i < column.size(); ++i) {
+          if (all_predicates(column[i], at_least, below, low_bits)) {
+            expected.push_back(static_cast<uint32_t>(i));
+          }
+        }
+      },
+      [&] { filter::select_all(view, rows, at_least, below, low_bits); });
+
+  // 先頭の述語でほぼすべてのワードが 0 になり、残りは評価されない
+  run(
+      "AND 先頭が 0.1% の述語",
+      [&] {
+        for (size_t i = 0; i < column.size(); ++i) {
+          if (all_predicates(column[i], rare, below, low_bits)) {
+            expected.push_back(static_cast<uint32_t>(i));
+          }
+        }
+      },
+      [&] { filter::select_all(view, rows, rare, below, low_bits); });
+
+  run(
+      "OR 2述語              ",
+      [&] {
+        for (size_t i = 0; i < column.size(); ++i) {
+          if (any_predicate(column[i], rare, low_bits)) {
+            expected.push_back(static_cast<uint32_t>(i));
+          }
+        }
+      },
+      [&] { filter::select_any(view, rows, rare, low_bits); });
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "列指向の述語フィルタのサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,183 @@
+// 列指向の述語フィルタ（ビットマスク + 選択ベクタ）
+// example.cpp / solution.cpp の all_predicates(value, preds...) は1値ずつ
+// すべての述語を呼ぶ。ここでは std::span<const T> の列全体に対して
+//   1. 64 要素ごとに、各述語を 64 要素まとめて評価して 64 ビットのマスクにする
+//      （比較のループはコンパイラが SIMD 命令にベクトル化する）
+//   2. 述語ごとのマスクを畳み込み式で AND / OR する
+//      AND はマスクが 0 になった時点で、OR は全ビットが立った時点で
+//      残りの述語を評価しない
+//   3. 立っているビットの位置を選択ベクタ（行番号の配列）に書き出す
+// という順で絞り込む。
+//
+// std::span を使うため C++20 でビルドする。
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace filter {
+
+inline constexpr size_t kWordBits = 64;
+
+namespace detail {
+
+// 0/1 のバイト8個を8ビットに詰める（バイト i -> ビット i）
+inline uint64_t pack_bytes(const uint8_t* flags) {
+  if constexpr (std::endian::native == std::endian::little) {
+    // 各バイトの最下位ビットを乗算で最上位バイトに集める
+    uint64_t bytes;
+    std::memcpy(&bytes, flags, sizeof(bytes));
+    return (bytes * 0x0102040810204080ull) >> 56;
+  } else {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < 8; ++i) {
+      bits |= static_cast<uint64_t>(flags[i]) << i;
+    }
+    return bits;
+  }
+}
+
+// data[0, count) に pred を適用し、結果をビットマスクで返す（count <= 64）
+template <typename T, typename Pred>
+uint64_t evaluate_word(const T* data, size_t count, const Pred& pred) {
+  // 分岐のない 0/1 のバイト列にしてから詰めると比較がベクトル化される
+  alignas(64) uint8_t flags[kWordBits] = {};
+  if (count == kWordBits) {
+    // 回数が定数のループは丸ごとベクタ命令に展開される
+    for (size_t i = 0; i < kWordBits; ++i) {
+      flags[i] = static_cast<uint8_t>(pred(data[i]) ? 1 : 0);
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      flags[i] = static_cast<uint8_t>(pred(data[i]) ? 1 : 0);
+    }
+  }
+  uint64_t mask = 0;
+  for (size_t chunk = 0; chunk < kWordBits / 8; ++chunk) {
+    mask |= pack_bytes(flags + chunk * 8) << (chunk * 8);
+  }
+  return mask;
+}
+
+inline uint64_t valid_bits(size_t count) {
+  return count == kWordBits ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+}
+
+// 1ワード分の AND（0 になったら残りの述語は評価しない）
+template <typename T, typename... Preds>
+uint64_t all_word(const T* data, size_t count, const Preds&... preds) {
+  uint64_t mask = valid_bits(count);
+  static_cast<void>(
+      (((mask &= evaluate_word(data, count, preds)) != 0) && ...));
+  return mask;
+}
+
+// 1ワード分の OR（全ビットが立ったら残りの述語は評価しない）
+template <typename T, typename... Preds>
+uint64_t any_word(const T* data, size_t count, const Preds&... preds) {
+  const uint64_t full = valid_bits(count);
+  uint64_t mask = 0;
+  static_cast<void>(
+      (((mask |= evaluate_word(data, count, preds)) != full) && ...));
+  return mask;
+}
+
+template <typename T, typename WordFunc>
+void build_bitmask(std::span<const T> column, std::vector<uint64_t>& words,
+                   WordFunc&& word_func) {
+  const size_t word_count = (column.size() + kWordBits - 1) / kWordBits;
+  words.resize(word_count);
+  for (size_t w = 0; w < word_count; ++w) {
+    size_t begin = w * kWordBits;
+    size_t count = std::min(kWordBits, column.size() - begin);
+    words[w] = word_func(column.data() + begin, count);
+  }
+}
+
+// bits の立っている位置に base を足して out に追記する
+inline void append_set_bits(uint64_t bits, uint32_t base,
+                            std::vector<uint32_t>& out) {
+  while (bits != 0) {
+    out.push_back(base + static_cast<uint32_t>(std::countr_zero(bits)));
+    bits &= bits - 1;  // 最下位の立っているビットを落とす
+  }
+}
+
+template <typename T, typename WordFunc>
+void build_selection(std::span<const T> column, std::vector<uint32_t>& out,
+                     WordFunc&& word_func) {
+  out.clear();
+  for (size_t begin = 0; begin < column.size(); begin += kWordBits) {
+    size_t count = std::min(kWordBits, column.size() - begin);
+    append_set_bits(word_func(column.data() + begin, count),
+                    static_cast<uint32_t>(begin), out);
+  }
+}
+
+}  // namespace detail
+
+// ============================================================================
+// ビットマスク
+// ============================================================================
+
+// words のビット i は column[i] がすべての述語を満たすか
+template <typename T, typename... Preds>
+void bitmask_all(std::span<const T> column, std::vector<uint64_t>& words,
+                 const Preds&... preds) {
+  static_assert(sizeof...(Preds) > 0, "述語を1つ以上指定してください");
+  detail::build_bitmask(column, words, [&](const T* data, size_t count) {
+    return detail::all_word(data, count, preds...);
+  });
+}
+
+// words のビット i は column[i] がいずれかの述語を満たすか
+template <typename T, typename... Preds>
+void bitmask_any(std::span<const T> column, std::vector<uint64_t>& words,
+                 const Preds&... preds) {
+  static_assert(sizeof...(Preds) > 0, "述語を1つ以上指定してください");
+  detail::build_bitmask(column, words, [&](const T* data, size_t count) {
+    return detail::any_word(data, count, preds...);
+  });
+}
+
+// ============================================================================
+// 選択ベクタ
+// ============================================================================
+
+// ビットマスクの立っている位置を行番号として out に書き出す
+inline void to_selection(std::span<const uint64_t> words,
+                         std::vector<uint32_t>& out) {
+  out.clear();
+  for (size_t w = 0; w < words.size(); ++w) {
+    detail::append_set_bits(words[w], static_cast<uint32_t>(w * kWordBits),
+                            out);
+  }
+}
+
+// すべての述語を満たす行の番号（マスクを経由せずワードごとに書き出す）
+template <typename T, typename... Preds>
+void select_all(std::span<const T> column, std::vector<uint32_t>& out,
+                const Preds&... preds) {
+  static_assert(sizeof...(Preds) > 0, "述語を1つ以上指定してください");
+  detail::build_selection(column, out, [&](const T* data, size_t count) {
+    return detail::all_word(data, count, preds...);
+  });
+}
+
+// いずれかの述語を満たす行の番号
+template <typename T, typename... Preds>
+void select_any(std::span<const T> column, std::vector<uint32_t>& out,
+                const Preds&... preds) {
+  static_assert(sizeof...(Preds) > 0, "述語を1つ以上指定してください");
+  detail::build_selection(column, out, [&](const T* data, size_t count) {
+    return detail::any_word(data, count, preds...);
+  });
+}
+
+}  // namespace filter
@@ -0,0 +1,161 @@
+// string_builder.h のサンプルとベンチマーク
+//   - 文字列と数値を混ぜた連結
+//   - append_to によるバッファの再利用
+//   - += 連結 / std::ostringstream との速度と確保回数の比較
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include "string_builder.h"
+
+// ============================================================================
+// 0. ヒープ確保回数の計測（グローバル operator new の置き換え）
+// ============================================================================
+
+std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ============================================================================
+// 1. 比較用: example.cpp と同じ += による連結
+// ============================================================================
+
+template <typename... Args>
+std::string concatenate_naive(Args... args) {
+  std::string result;
+  ((result += args), ...);
+  return result;
+}
+
+// ============================================================================
+// 2. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 数値を含む連結 ===" << std::endl;
+
+  std::cout << strings::concatenate("Hello", ' ', std::string("World"), "!")
+            << std::endl;
+  std::cout << strings::concatenate("player:", 42, ":hp=", -7, ":ratio=",
+                                    0.125, ":alive=", true)
+            << std::endl;
+  std::cout << strings::concatenate("int64 min: ",
+                                    std::numeric_limits<int64_t>::min())
+            << std::endl;
+
+  // 同じバッファに追記していく
+  std::string buffer;
+  buffer.reserve(64);
+  for (int i = 0; i < 3; ++i) {
+    buffer.clear();
+    strings::append_to(buffer, "frame ", i, " dt=", 0.016f);
+    std::cout << buffer << " (capacity " << buffer.capacity() << ")"
+              << std::endl;
+  }
+
+  // 自分自身を引数に渡しても、読む前に壊さない
+  std::string self = "abc";
+  strings::append_to(self, "-", self, '-', std::string_view(self).substr(1));
+  std::cout << "自分自身を追記: " << self << std::endl;
+
+  // buffer の中の char を参照で渡す（SSO の短い文字列と、ヒープ上の長い文字列）
+  std::string short_text = "ab";
+  strings::append_to(short_text, short_text[0], short_text.back());
+  std::string long_text(40, 'x');
+  long_text += "yz";
+  strings::append_to(long_text, '-', long_text.back(), long_text[1]);
+  std::cout << "自分の char を追記: " << short_text << " / "
+            << std::string_view(long_text).substr(38) << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 3. ベンチマーク: リクエストキーの組み立て
+// ============================================================================
+
+template <typename Build>
+void run_benchmark(const char* label, Build&& build) {
+  constexpr int kIterations = 2000000;
+  size_t before = g_allocations;
+  size_t checksum = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    checksum += build(i);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  double per_sec = kIterations / elapsed.count() / 1e6;
+  std::cout << label << ": " << elapsed.count() * 1000.0 << " ms ("
+            << per_sec << " M回/s), ヒープ確保 "
+            << static_cast<double>(g_allocations - before) / kIterations
+            << " 回/件 (checksum " << checksum << ")" << std::endl;
+}
+
+void benchmark_example() {
+  std::cout << "=== ベンチマーク（キー組み立て x 2,000,000）===" << std::endl;
+
+  const std::string region = "ap-northeast-1";
+  const std::string user = "itsakeyfut";
+
+  run_benchmark("+= と std::to_string   ", [&](int i) {
+    std::string key = concatenate_naive(
+        std::string("session:"), region, std::string(":"), user,
+        std::string(":"), std::to_string(i), std::string(":shard-"),
+        std::to_string(i % 64));
+    return key.size();
+  });
+
+  run_benchmark("std::ostringstream     ", [&](int i) {
+    std::ostringstream out;
+    out << "session:" << region << ":" << user << ":" << i << ":shard-"
+        << i % 64;
+    return out.str().size();
+  });
+
+  run_benchmark("strings::concatenate   ", [&](int i) {
+    std::string key = strings::concatenate("session:", region, ':', user, ':',
+                                           i, ":shard-", i % 64);
+    return key.size();
+  });
+
+  std::string buffer;
+  run_benchmark("strings::append_to 再利用", [&](int i) {
+    buffer.clear();
+    strings::append_to(buffer, "session:", region, ':', user, ':', i,
+                       ":shard-", i % 64);
+    return buffer.size();
+  });
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "1回の確保で済む文字列連結のサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,158 @@
+// 1回の確保で済む可変長引数の文字列連結
+// example.cpp の concatenate は (result += args, ...) で1つずつ追記するため、
+// 引数が多いと途中で何度も再確保が起き、数値も渡せない。
+// ここでは
+//   1. 畳み込み式で全体の長さを先に求める
+//   2. 一度だけ確保する
+//   3. 文字列はコピー、数値は std::to_chars で同じバッファに直接書く
+// という順で連結する。append_to(buffer, args...) は既存のバッファの末尾に
+// 追記するので、同じバッファを使い回せば定常状態では確保が起きない。
+
+#pragma once
+
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace strings {
+
+namespace detail {
+
+template <typename T>
+inline constexpr bool is_string_like_v =
+    std::is_convertible_v<const T&, std::string_view>;
+
+// 符号なし整数の10進桁数
+template <typename U>
+constexpr size_t count_digits(U value) {
+  size_t digits = 1;
+  while (value >= 10) {
+    value /= 10;
+    ++digits;
+  }
+  return digits;
+}
+
+// 浮動小数点を最短表現で書いたときの長さの上限
+// （符号 + 有効桁 + 小数点 + 指数部 "e-308"）
+template <typename F>
+constexpr size_t max_float_chars() {
+  return 1 + std::numeric_limits<F>::max_digits10 + 1 + 5;
+}
+
+// 1引数分の長さ。浮動小数点だけは上限を返す（書いた後に切り詰める）
+template <typename T>
+constexpr size_t piece_length(const T& arg) {
+  if constexpr (is_string_like_v<T>) {
+    return std::string_view(arg).size();
+  } else if constexpr (std::is_same_v<T, char>) {
+    return 1;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return arg ? 4 : 5;
+  } else if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    if constexpr (std::is_signed_v<T>) {
+      if (arg < 0) {
+        // 最小値でもオーバーフローしないよう符号なしで反転する
+        return 1 + count_digits(static_cast<U>(U{0} - static_cast<U>(arg)));
+      }
+    }
+    return count_digits(static_cast<U>(arg));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return max_float_chars<T>();
+  } else {
+    static_assert(!std::is_same_v<T, T>, "この型は連結できません");
+  }
+}
+
+// out に1引数分を書き、書いた直後の位置を返す
+template <typename T>
+char* write_piece(char* out, char* end, const T& arg) {
+  if constexpr (is_string_like_v<T>) {
+    std::string_view text(arg);
+    if (!text.empty()) {
+      std::memcpy(out, text.data(), text.size());
+    }
+    return out + text.size();
+  } else if constexpr (std::is_same_v<T, char>) {
+    *out = arg;
+    return out + 1;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    std::string_view text = arg ? "true" : "false";
+    std::memcpy(out, text.data(), text.size());
+    return out + text.size();
+  } else {
+    // 長さは piece_length で確保済みなので失敗しないはず。失敗したときの
+    // [out, end) の中身は不定なので、途中まで書かれた値を残さず何も書かない
+    auto [ptr, ec] = std::to_chars(out, end, arg);
+    assert(ec == std::errc() && "piece_length の見積もりが足りない");
+    return ec == std::errc() ? ptr : out;
+  }
+}
+
+// arg が buffer の中身を指しているか（resize で読めなくなる引数）。
+// 文字列は指している先を、それ以外（h.back() などの char& も含む）は
+// 引数そのもののアドレスを、buffer の領域 [data, data + capacity] と比べる
+template <typename T>
+bool aliases(const std::string& buffer, const T& arg) {
+  const char* first;
+  const char* last;
+  if constexpr (is_string_like_v<T>) {
+    std::string_view text(arg);
+    first = text.data();
+    last = first + text.size();
+  } else {
+    first = reinterpret_cast<const char*>(std::addressof(arg));
+    last = first + sizeof(T);
+  }
+  const char* begin = buffer.data();
+  const char* end = begin + buffer.capacity() + 1;  // 終端の '\0' まで
+  std::less<const char*> lt;
+  std::less_equal<const char*> le;
+  return le(begin, first) ? lt(first, end) : lt(begin, last);
+}
+
+}  // namespace detail
+
+// buffer の末尾に args を連結する。確保は高々1回
+// append_to(s, "-", s) や append_to(s, s.back()) のように buffer の中を指す引数があると、resize の再確保や
+// 書き込みで読む前に壊れるので、そのときだけ一時バッファで組み立ててから追記する
+template <typename... Args>
+std::string& append_to(std::string& buffer, const Args&... args) {
+  if ((detail::aliases(buffer, args) || ...)) {
+    std::string joined;
+    append_to(joined, args...);
+    return buffer.append(joined);
+  }
+
+  const size_t old_size = buffer.size();
+  const size_t max_size =
+      old_size + (size_t{0} + ... + detail::piece_length(args));
+  buffer.resize(max_size);
+
+  char* out = buffer.data() + old_size;
+  char* end = buffer.data() + max_size;
+  ((out = detail::write_piece(out, end, args)), ...);
+
+  // 浮動小数点の上限との差だけ切り詰める（再確保は起きない）
+  buffer.resize(static_cast<size_t>(out - buffer.data()));
+  return buffer;
+}
+
+template <typename... Args>
+std::string concatenate(const Args&... args) {
+  std::string result;
+  append_to(result, args...);
+  return result;
+}
+
+}  // namespace strings
@@ -0,0 +1,64 @@
+# zero_cost.cpp のアセンブリで、sum_plain と sum_with_disabled_logging の
+# 命令列が一致することを確認する
+#   cmake -DASM_FILE=zero_cost.s -P check_zero_cost.cmake
+
+if(NOT ASM_FILE)
+    message(FATAL_ERROR "ASM_FILE を指定してください")
+endif()
+
+# 角括弧とセミコロンは CMake のリストを壊すので、行に分ける前に置き換える
+file(READ ${ASM_FILE} asm_text)
+string(REPLACE ";" "," asm_text "${asm_text}")
+string(REPLACE "[" "(" asm_text "${asm_text}")
+string(REPLACE "]" ")" asm_text "${asm_text}")
+string(REPLACE "\n" ";" asm_lines "${asm_text}")
+
+# 関数ラベルから .cfi_endproc までの命令を取り出し、
+# ローカルラベル番号とディレクティブを取り除いて正規化する
+function(extract_body name out_var)
+    set(inside FALSE)
+    set(body "")
+    foreach(line IN LISTS asm_lines)
+        if(line MATCHES "^_?${name}:")
+            set(inside TRUE)
+            continue()
+        endif()
+        if(inside)
+            if(line MATCHES "\\.cfi_endproc" OR line MATCHES "^\\.Lfunc_end")
+                break()
+            endif()
+            string(STRIP "${line}" line)
+            if(line STREQUAL "" OR line MATCHES "^\\.(cfi|p2align|align|loc)")
+                continue()
+            endif()
+            string(REGEX REPLACE "\\.L[A-Za-z_]*[0-9]+" ".L" line "${line}")
+            string(REGEX REPLACE "[ \t]*#.*$" "" line "${line}")
+            list(APPEND body "${line}")
+        endif()
+    endforeach()
+    if(NOT body)
+        message(FATAL_ERROR "${name} が ${ASM_FILE} に見つかりません")
+    endif()
+    set(${out_var} "${body}" PARENT_SCOPE)
+endfunction()
+
+extract_body(sum_plain plain)
+extract_body(sum_with_disabled_logging disabled)
+extract_body(sum_with_legacy_logging legacy)
+
+list(LENGTH plain plain_count)
+list(LENGTH disabled disabled_count)
+list(LENGTH legacy legacy_count)
+message(STATUS "sum_plain                : ${plain_count} 行")
+message(STATUS "sum_with_disabled_logging: ${disabled_count} 行")
+message(STATUS "sum_with_legacy_logging  : ${legacy_count} 行")
+
+if(NOT plain STREQUAL disabled)
+    string(REPLACE ";" "\n" plain_text "${plain}")
+    string(REPLACE ";" "\n" disabled_text "${disabled}")
+    message(FATAL_ERROR
+        "無効なログ呼び出しがコードを生成しています\n"
+        "--- sum_plain ---\n${plain_text}\n"
+        "--- sum_with_disabled_logging ---\n${disabled_text}")
+endif()
+message(STATUS "OK: 無効なログ呼び出しは命令を生成していません")
@@ -0,0 +1,113 @@
+// static_logger.h のサンプルとベンチマーク
+//   - コンパイル時/実行時のレベル判定
+//   - 無効な呼び出しで引数が評価されないこと
+//   - ホットループにログを残したときのコスト（zero_cost.cpp の関数を呼ぶ）
+// 逆アセンブルでの確認は `cmake --build . --target check_zero_cost`。
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "static_logger.h"
+
+extern "C" int64_t sum_plain(const int32_t* data, size_t size);
+extern "C" int64_t sum_with_disabled_logging(const int32_t* data, size_t size);
+extern "C" int64_t sum_with_runtime_filtered(const int32_t* data, size_t size);
+extern "C" int64_t sum_with_legacy_logging(const int32_t* data, size_t size);
+
+// zero_cost.cpp から参照される。エラーだけを出力する（警告以下は出さない）
+logging::Logger g_logger(std::clog, logging::LogLevel::kError);
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== レベル判定 ===" << std::endl;
+  std::cout << "コンパイル時の最低レベル: "
+            << logging::to_string(logging::kMinLogLevel) << std::endl;
+
+  logging::Logger logger(std::cout, logging::LogLevel::kTrace);
+
+  int evaluated = 0;
+  auto expensive = [&] {
+    ++evaluated;
+    return std::string("高価な文字列");
+  };
+
+  LOG_DEBUG(logger, "debug: ", expensive());
+  LOG_INFO(logger, "info: ", expensive());
+  LOG_ERROR(logger, "error: code=", 42);
+  std::cout << "expensive() の評価回数: " << evaluated
+            << "（DEBUG がコンパイル時に無効なら 1）" << std::endl;
+
+  // 関数版: 引数は評価されるが、ラムダなら有効なときだけ呼ばれる
+  evaluated = 0;
+  logger.log<logging::LogLevel::kTrace>("trace: ", expensive);
+  logger.log<logging::LogLevel::kWarn>("warn: ", expensive);
+  std::cout << "ラムダで渡した expensive の評価回数: " << evaluated
+            << std::endl;
+
+  // 実行時にレベルを上げる
+  logger.set_level(logging::LogLevel::kError);
+  LOG_WARN(logger, "この行は出力されない");
+  LOG_ERROR(logger, "実行時レベル ERROR でも出力される");
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+void run_benchmark(const char* label, const std::vector<int32_t>& data,
+                   Func&& func) {
+  constexpr int kRounds = 20;
+  int64_t checksum = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    checksum += func(data.data(), data.size());
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << label << ": " << elapsed.count() / kRounds
+            << " ms/回 (checksum " << checksum << ")" << std::endl;
+}
+
+void benchmark_example() {
+  constexpr size_t kSize = 1000000;
+  std::cout << "=== ベンチマーク（" << kSize << " 要素の合計）===" << std::endl;
+
+  std::vector<int32_t> data(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    data[i] = static_cast<int32_t>(i % 1000) - (i % 100000 == 0 ? 5000 : 0);
+  }
+
+  run_benchmark("ログなし                    ", data, sum_plain);
+  run_benchmark("LOG_DEBUG（コンパイル時に無効）", data,
+                sum_with_disabled_logging);
+  run_benchmark("LOG_WARN（実行時に抑制）      ", data,
+                sum_with_runtime_filtered);
+  run_benchmark("従来の Logger（引数を評価）   ", data,
+                sum_with_legacy_logging);
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "コンパイル時にレベルで除去されるロガーのサンプル\n"
+            << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
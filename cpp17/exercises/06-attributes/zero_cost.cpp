@@ -0,0 +1,68 @@
+// ログ呼び出しのコスト比較用の関数
+// static_logger のベンチマークから呼ばれ、check_zero_cost.cmake で
+// アセンブリを比較される。LOG_MIN_LEVEL=2（kInfo）でコンパイルすること。
+//   - sum_plain                   : ログなし
+//   - sum_with_disabled_logging   : LOG_DEBUG（コンパイル時に無効）
+//   - sum_with_runtime_filtered   : LOG_WARN（有効だが実行時レベルで抑制）
+//   - sum_with_legacy_logging     : example.cpp 方式（引数は常に評価される）
+// sum_plain と sum_with_disabled_logging は同じ命令列になる。
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "static_logger.h"
+
+// example.cpp の Logger と同じ形（NDEBUG で本体が空になる）
+class LegacyLogger {
+ public:
+  void log([[maybe_unused]] const std::string& message) {
+#ifndef NDEBUG
+    std::cout << "[LOG] " << message << std::endl;
+#endif
+  }
+};
+
+extern logging::Logger g_logger;
+LegacyLogger g_legacy_logger;
+
+extern "C" int64_t sum_plain(const int32_t* data, size_t size) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < size; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+extern "C" int64_t sum_with_disabled_logging(const int32_t* data,
+                                             size_t size) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < size; ++i) {
+    LOG_DEBUG(g_logger, "i=", i, " value=", std::to_string(data[i]));
+    sum += data[i];
+  }
+  return sum;
+}
+
+extern "C" int64_t sum_with_runtime_filtered(const int32_t* data,
+                                             size_t size) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] < 0) {
+      LOG_WARN(g_logger, "negative value at ", i, ": ", data[i]);
+    }
+    sum += data[i];
+  }
+  return sum;
+}
+
+extern "C" int64_t sum_with_legacy_logging(const int32_t* data, size_t size) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < size; ++i) {
+    g_legacy_logger.log("i=" + std::to_string(i) +
+                        " value=" + std::to_string(data[i]));
+    sum += data[i];
+  }
+  return sum;
+}
@@ -0,0 +1,216 @@
+// config_loader.h のサンプルとベンチマーク
+//   - セクション・コメント・引用符付きの値を読む
+//   - 50MB の設定ファイルを iostream で1行ずつ読む場合と比較する
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "config_loader.h"
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== INI の読み込み ===" << std::endl;
+
+  constexpr std::string_view kText =
+      "; ゲームの設定\n"
+      "title = My Awesome Game   ; 行末コメント\n"
+      "\n"
+      "[graphics]\n"
+      "width = 1920\n"
+      "height=1080\n"
+      "gamma = 2.2\n"
+      "fullscreen = true\n"
+      "\n"
+      "[paths]\n"
+      "save = 'C:\\Games\\Save'\n"
+      "motd = \"Welcome; \\\"player\\\"\"\n"
+      "color = \"#ff8800\"    ; # で始まる値は引用符で囲む\n"
+      "empty = # 値なし\n";
+
+  config::ConfigLoader loader;
+  if (!loader.load_string(kText)) {
+    std::cout << loader.error_line() << " 行目: " << loader.error()
+              << std::endl;
+    return;
+  }
+
+  std::cout << "エントリ数: " << loader.size() << std::endl;
+  std::cout << "title: " << loader.get("title").value_or("?") << std::endl;
+  std::cout << "graphics.width: "
+            << loader.get_int("graphics.width").value_or(-1) << std::endl;
+  std::cout << "graphics.gamma: "
+            << loader.get_double("graphics.gamma").value_or(1.0) << std::endl;
+  std::cout << "graphics.fullscreen: "
+            << loader.get_bool("graphics.fullscreen").value_or(false)
+            << std::endl;
+  std::cout << "paths.save: " << loader.get("paths.save").value_or("?")
+            << std::endl;
+  std::cout << "paths.motd: " << loader.get("paths.motd").value_or("?")
+            << std::endl;
+  std::cout << "paths.color: " << loader.get("paths.color").value_or("?")
+            << std::endl;
+  std::cout << "paths.empty: \"" << loader.get("paths.empty").value_or("?")
+            << "\"" << std::endl;
+
+  // 書式エラーは行番号つきで報告される
+  if (!loader.load_string("[broken\nkey = value\n")) {
+    std::cout << "エラー: " << loader.error_line() << " 行目: "
+              << loader.error() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. 比較用: iostream で1行ずつ読むローダー
+// ============================================================================
+
+std::string trim_copy(const std::string& text) {
+  size_t begin = text.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  size_t end = text.find_last_not_of(" \t\r");
+  return text.substr(begin, end - begin + 1);
+}
+
+bool legacy_load(const std::string& path,
+                 std::unordered_map<std::string, std::string>& data) {
+  std::ifstream input(path);
+  if (!input) {
+    return false;
+  }
+  std::string line;
+  std::string section;
+  while (std::getline(input, line)) {
+    line = trim_copy(line);
+    if (line.empty() || line[0] == ';' || line[0] == '#') {
+      continue;
+    }
+    if (line[0] == '[') {
+      section = trim_copy(line.substr(1, line.find(']') - 1));
+      continue;
+    }
+    size_t equal = line.find('=');
+    if (equal == std::string::npos) {
+      return false;
+    }
+    std::string key = trim_copy(line.substr(0, equal));
+    std::string value = trim_copy(line.substr(equal + 1));
+    if (value.size() >= 2 && value.front() == '"') {
+      value = value.substr(1, value.find('"', 1) - 1);
+    } else if (size_t comment = value.find(" ;");
+               comment != std::string::npos) {
+      value = trim_copy(value.substr(0, comment));
+    }
+    if (!section.empty()) {
+      key = section + "." + key;
+    }
+    data[key] = value;
+  }
+  return true;
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+size_t generate_config(const std::string& path, size_t target_bytes) {
+  std::ofstream output(path, std::ios::binary);
+  size_t written = 0;
+  char line[128];
+  for (int section = 0; written < target_bytes; ++section) {
+    int n = std::snprintf(line, sizeof(line), "\n[service_%d]\n", section);
+    output.write(line, n);
+    written += static_cast<size_t>(n);
+    for (int key = 0; key < 1000; ++key) {
+      switch (key % 4) {
+        case 0:
+          n = std::snprintf(line, sizeof(line), "timeout_%d = %d\n", key,
+                            key * 7);
+          break;
+        case 1:
+          n = std::snprintf(line, sizeof(line),
+                            "endpoint_%d = \"https://svc%d.example.com/v1\"\n",
+                            key, section);
+          break;
+        case 2:
+          n = std::snprintf(line, sizeof(line),
+                            "enabled_%d = true   ; 行末コメント\n", key);
+          break;
+        default:
+          n = std::snprintf(line, sizeof(line), "# %d 番目の設定の説明\n",
+                            key);
+          break;
+      }
+      output.write(line, n);
+      written += static_cast<size_t>(n);
+    }
+  }
+  return written;
+}
+
+template <typename Func>
+double measure_ms(Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count();
+}
+
+void benchmark_example() {
+  constexpr size_t kTargetBytes = 50 * 1024 * 1024;
+  std::string path =
+      (std::filesystem::temp_directory_path() / "config_loader_bench.ini")
+          .string();
+  size_t bytes = generate_config(path, kTargetBytes);
+  double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+  std::cout << "=== ベンチマーク（" << megabytes << " MB の設定ファイル）==="
+            << std::endl;
+
+  std::unordered_map<std::string, std::string> legacy;
+  double legacy_ms = measure_ms([&] { legacy_load(path, legacy); });
+  std::cout << "iostream + getline : " << legacy_ms << " ms ("
+            << megabytes / (legacy_ms / 1000.0) << " MB/s, " << legacy.size()
+            << " エントリ)" << std::endl;
+
+  config::ConfigLoader loader;
+  bool ok = false;
+  double mapped_ms = measure_ms([&] { ok = loader.load_file(path); });
+  std::cout << "mmap + string_view : " << mapped_ms << " ms ("
+            << megabytes / (mapped_ms / 1000.0) << " MB/s, " << loader.size()
+            << " エントリ)" << (ok ? "" : " 失敗") << std::endl;
+
+  // 両方で同じ値が読めていることを確認する
+  const char* key = "service_7.endpoint_1";
+  std::cout << key << ": " << legacy[key] << " / "
+            << loader.get(key).value_or("?") << std::endl;
+
+  loader.clear();
+  std::filesystem::remove(path);
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "メモリマップで読むゼロコピー INI ローダーのサンプル\n"
+            << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,374 @@
+// ファイルをメモリマップして1パスで読む INI ローダー
+// iostream で1行ずつ std::getline して std::string に切り出すと、
+// 行ごと・キーごと・値ごとにヒープ確保とコピーが走る。ここでは
+//   - ファイル全体を mmap（Windows は MapViewOfFile）でそのまま読み
+//   - memchr で改行を探しながら1パスで切り出し
+//   - キーと値はマッピング内を指す std::string_view として ConfigParser に登録する
+// ので、ほとんどの行でヒープ確保もコピーも起きない。
+// コピーが必要になるのは次の2つだけで、どちらもブロック単位のアリーナに置く。
+//   - セクション内のキー（"section.key" を組み立てる）
+//   - エスケープ（\" \\ \n \t）を含む二重引用符の値
+//
+// 書式:
+//   ; コメント / # コメント
+//   [section]
+//   key = value            ; 空白の後ろの ; と # 以降はコメント
+//   name = "quoted ; value" （引用符の中はコメントにならない）
+//   path = 'C:\raw\path'   （単一引用符はエスケープを解釈しない）
+//
+// 値はローダー（とマッピング）が生きている間だけ有効。
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "config_parser.h"
+
+namespace config {
+
+// ============================================================================
+// 読み取り専用のファイルマッピング
+// ============================================================================
+
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile() { close(); }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool open(const std::string& path) {
+    close();
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+      CloseHandle(file);
+      return false;
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) {
+      CloseHandle(file);
+      return true;
+    }
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+      size_ = 0;
+      return false;
+    }
+    data_ = static_cast<const char*>(
+        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      ::close(fd);
+      return false;
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+      ::close(fd);
+      return true;
+    }
+    void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      size_ = 0;
+      return false;
+    }
+    // 先頭から順に読むので先読みを強めにしてもらう
+    madvise(address, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(address);
+#endif
+    if (data_ == nullptr) {
+      size_ = 0;
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+    if (data_ != nullptr) {
+#if defined(_WIN32)
+      UnmapViewOfFile(data_);
+#else
+      munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  std::string_view view() const { return {data_, size_}; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// ============================================================================
+// 組み立てたキーやエスケープを解いた値を置く領域
+// ============================================================================
+
+// 64KB のブロックから切り出すだけ。個別には解放しない
+class StringArena {
+ public:
+  char* allocate(size_t size) {
+    if (size > left_) {
+      size_t block = std::max(kBlockSize, size);
+      blocks_.emplace_back(new char[block]);
+      cursor_ = blocks_.back().get();
+      left_ = block;
+    }
+    char* result = cursor_;
+    cursor_ += size;
+    left_ -= size;
+    return result;
+  }
+
+  std::string_view join(std::string_view prefix, char separator,
+                        std::string_view name) {
+    size_t size = prefix.size() + 1 + name.size();
+    char* out = allocate(size);
+    std::memcpy(out, prefix.data(), prefix.size());
+    out[prefix.size()] = separator;
+    std::memcpy(out + prefix.size() + 1, name.data(), name.size());
+    return {out, size};
+  }
+
+  void clear() {
+    blocks_.clear();
+    cursor_ = nullptr;
+    left_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* cursor_ = nullptr;
+  size_t left_ = 0;
+};
+
+// ============================================================================
+// ローダー
+// ============================================================================
+
+class ConfigLoader : public ConfigParser {
+ public:
+  // ファイルをマップして読み込む。失敗したら false（error() に理由）。
+  // 書式エラーの場合、その行より前のエントリは登録済みのまま残る
+  bool load_file(const std::string& path) {
+    clear();
+    if (!file_.open(path)) {
+      error_ = "ファイルを開けません";
+      return false;
+    }
+    return parse(file_.view());
+  }
+
+  // メモリ上のテキストを読み込む（text はローダーより長く生きること）
+  bool load_string(std::string_view text) {
+    clear();
+    return parse(text);
+  }
+
+  void clear() {
+    ConfigParser::clear();
+    arena_.clear();
+    file_.close();
+    error_ = {};
+    error_line_ = 0;
+  }
+
+  // 最初に見つかった書式エラー（なければ空と 0）
+  std::string_view error() const { return error_; }
+  size_t error_line() const { return error_line_; }
+
+ private:
+  static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  static std::string_view trim(std::string_view text) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && is_space(text[begin])) {
+      ++begin;
+    }
+    while (end > begin && is_space(text[end - 1])) {
+      --end;
+    }
+    return text.substr(begin, end - begin);
+  }
+
+  // 先頭か空白の直後にある ; / # 以降を捨てる
+  static std::string_view strip_comment(std::string_view text) {
+    for (size_t i = 0; i < text.size(); ++i) {
+      if ((text[i] == ';' || text[i] == '#') &&
+          (i == 0 || is_space(text[i - 1]))) {
+        return text.substr(0, i);
+      }
+    }
+    return text;
+  }
+
+  bool parse(std::string_view text) {
+    // UTF-8 の BOM を読み飛ばす
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+      text.remove_prefix(3);
+    }
+    // 行数を上限としてハッシュ表を先に確保し、再ハッシュを避ける
+    reserve(static_cast<size_t>(
+        std::count(text.begin(), text.end(), '\n') + 1));
+
+    std::string_view section;
+    const char* cursor = text.data();
+    const char* end = cursor + text.size();
+    size_t line_number = 0;
+    while (cursor < end) {
+      const char* newline = static_cast<const char*>(
+          std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+      const char* line_end = newline != nullptr ? newline : end;
+      std::string_view line(cursor, static_cast<size_t>(line_end - cursor));
+      cursor = newline != nullptr ? newline + 1 : end;
+      ++line_number;
+
+      if (!parse_line(trim(line), section)) {
+        error_line_ = line_number;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool parse_line(std::string_view line, std::string_view& section) {
+    if (line.empty() || line[0] == ';' || line[0] == '#') {
+      return true;
+    }
+
+    if (line[0] == '[') {
+      size_t close = line.find(']');
+      if (close == std::string_view::npos ||
+          !trim(strip_comment(line.substr(close + 1))).empty()) {
+        error_ = "セクション名が ] で閉じられていません";
+        return false;
+      }
+      section = trim(line.substr(1, close - 1));
+      return true;
+    }
+
+    size_t equal = line.find('=');
+    if (equal == std::string_view::npos) {
+      error_ = "= がありません";
+      return false;
+    }
+    std::string_view key = trim(line.substr(0, equal));
+    if (key.empty()) {
+      error_ = "キーが空です";
+      return false;
+    }
+
+    std::string_view value = trim(line.substr(equal + 1));
+    if (!value.empty() && (value[0] == '"' || value[0] == '\'')) {
+      if (!parse_quoted(value)) {
+        return false;
+      }
+    } else {
+      value = trim(strip_comment(value));
+    }
+
+    if (!section.empty()) {
+      key = arena_.join(section, '.', key);
+    }
+    set_view(key, value);
+    return true;
+  }
+
+  // value は引用符で始まる。成功すれば value を中身に置き換える
+  bool parse_quoted(std::string_view& value) {
+    const char quote = value[0];
+    bool escaped = false;
+    size_t close = 1;
+    for (; close < value.size(); ++close) {
+      if (value[close] == quote) {
+        break;
+      }
+      if (quote == '"' && value[close] == '\\') {
+        escaped = true;
+        ++close;
+      }
+    }
+    if (close >= value.size()) {
+      error_ = "引用符が閉じられていません";
+      return false;
+    }
+    if (!trim(strip_comment(value.substr(close + 1))).empty()) {
+      error_ = "引用符の後ろに余分な文字があります";
+      return false;
+    }
+
+    std::string_view inner = value.substr(1, close - 1);
+    value = escaped ? unescape(inner) : inner;
+    return true;
+  }
+
+  std::string_view unescape(std::string_view text) {
+    char* out = arena_.allocate(text.size());
+    size_t size = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+      char c = text[i];
+      if (c == '\\' && i + 1 < text.size()) {
+        c = text[++i];
+        if (c == 'n') {
+          c = '\n';
+        } else if (c == 't') {
+          c = '\t';
+        }
+      }
+      out[size++] = c;
+    }
+    return {out, size};
+  }
+
+  MappedFile file_;
+  StringArena arena_;
+  std::string_view error_;
+  size_t error_line_ = 0;
+};
+
+}  // namespace config
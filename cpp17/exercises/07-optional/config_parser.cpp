@@ -0,0 +1,184 @@
+// config_parser.h のサンプルとベンチマーク
+//   - string_view での取得と from_chars による型変換
+//   - solution.cpp の ConfigParser との速度・確保回数の比較
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "config_parser.h"
+
+// ============================================================================
+// 0. ヒープ確保回数の計測（グローバル operator new の置き換え）
+// ============================================================================
+
+std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ============================================================================
+// 1. 比較用: solution.cpp と同じ ConfigParser
+// ============================================================================
+
+class LegacyConfigParser {
+ private:
+  std::unordered_map<std::string, std::string> data_;
+
+ public:
+  void set(const std::string& key, const std::string& value) {
+    data_[key] = value;
+  }
+
+  std::optional<std::string> get(const std::string& key) const {
+    auto it = data_.find(key);
+    if (it != data_.end()) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  std::optional<int> get_int(const std::string& key) const {
+    auto value = get(key);
+    if (!value) {
+      return std::nullopt;
+    }
+
+    try {
+      return std::stoi(*value);
+    } catch (...) {
+      return std::nullopt;
+    }
+  }
+};
+
+// ============================================================================
+// 2. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== string_view と from_chars ===" << std::endl;
+
+  config::ConfigParser config;
+  config.set("game_title", "My Awesome Game");
+  config.set("screen_width", "1920");
+  config.set("gamma", "2.2");
+  config.set("fullscreen", "true");
+  config.set("invalid_number", "123abc");
+
+  if (auto title = config.get("game_title")) {
+    std::cout << "Game Title: " << *title << std::endl;
+  }
+  std::cout << "Developer: " << config.get("developer").value_or("Unknown")
+            << std::endl;
+
+  // std::string でも const char* でも一時オブジェクトなしに引ける
+  std::string key = "screen_width";
+  std::cout << "Screen Width: " << config.get_int(key).value_or(-1)
+            << std::endl;
+  std::cout << "Gamma: " << config.get_double("gamma").value_or(1.0)
+            << std::endl;
+  std::cout << "Fullscreen: " << config.get_bool("fullscreen").value_or(false)
+            << std::endl;
+  std::cout << "invalid_number (\"123abc\") を整数で: "
+            << (config.get_int("invalid_number") ? "変換できた" : "nullopt")
+            << std::endl;
+
+  // 値を上書きするとキャッシュも捨てられる
+  config.set("screen_width", "2560");
+  std::cout << "上書き後の Screen Width: " << *config.get_int("screen_width")
+            << std::endl;
+
+  // 同じキーを何度上書きしても、キーごとの文字列を使い回す
+  size_t before = g_allocations;
+  for (int i = 0; i < 100000; ++i) {
+    config.set("screen_width", i % 2 == 0 ? "3840" : "1280");
+  }
+  std::cout << "10万回上書き: ヒープ確保 " << g_allocations - before
+            << " 回, 値 " << *config.get("screen_width") << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+void run_benchmark(const char* label, Func&& func) {
+  constexpr int kIterations = 5000000;
+  size_t before = g_allocations;
+  long long checksum = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    checksum += func();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << label << ": " << elapsed.count() / kIterations
+            << " ns/回, ヒープ確保 "
+            << static_cast<double>(g_allocations - before) / kIterations
+            << " 回/回 (checksum " << checksum << ")" << std::endl;
+}
+
+void benchmark_example() {
+  std::cout << "=== ベンチマーク（5,000,000 回の読み取り）===" << std::endl;
+
+  LegacyConfigParser legacy;
+  config::ConfigParser fast;
+  for (int i = 0; i < 200; ++i) {
+    std::string key = "service.worker_pool.setting_" + std::to_string(i);
+    legacy.set(key, std::to_string(i * 10));
+    fast.set(key, std::to_string(i * 10));
+  }
+  legacy.set("service.request.timeout_milliseconds", "2500");
+  fast.set("service.request.timeout_milliseconds", "2500");
+  legacy.set("service.request.upstream_endpoint", "https://api.example.com/v1");
+  fast.set("service.request.upstream_endpoint", "https://api.example.com/v1");
+
+  run_benchmark("従来 get（文字列のコピー）  ", [&] {
+    return static_cast<long long>(
+        legacy.get("service.request.upstream_endpoint")->size());
+  });
+  run_benchmark("新 get（string_view）        ", [&] {
+    return static_cast<long long>(
+        fast.get("service.request.upstream_endpoint")->size());
+  });
+  run_benchmark("従来 get_int（stoi）         ", [&] {
+    return static_cast<long long>(
+        *legacy.get_int("service.request.timeout_milliseconds"));
+  });
+  run_benchmark("新 get_int（キャッシュ済み） ", [&] {
+    return static_cast<long long>(
+        *fast.get_int("service.request.timeout_milliseconds"));
+  });
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "確保なしで引ける ConfigParser のサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
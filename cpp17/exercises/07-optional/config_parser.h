@@ -0,0 +1,207 @@
+// 確保なしで引ける ConfigParser
+// solution.cpp の ConfigParser は
+//   - get(const std::string&) に文字列リテラルを渡すたびに std::string を作り
+//   - 値を std::optional<std::string> にコピーして返し
+//   - get_int は std::stoi + try/catch(...) で変換する
+// ので、ホットパスで呼ぶと毎回ヒープ確保と変換が走る。ここでは
+//   - キーは std::string_view で、透過的ハッシュ（is_transparent）により
+//     std::string / const char* / string_view のどれでも一時オブジェクトなしに引く
+//   - 値は std::optional<std::string_view> で返す（コピーしない）
+//   - get_int / get_double / get_bool は std::from_chars で例外なしに変換する
+//   - 変換結果はキーごとにキャッシュし、2回目以降はハッシュ表を1回引くだけ
+// とする。
+//
+// 読み取り（get 系）は複数スレッドから同時に呼んでよい。キャッシュは
+// アトミック変数なので、同じキーを同時に初めて変換しても壊れない。
+// set は読み取りと同時に呼ばないこと。
+//
+// set で既存のキーを上書きすると、そのキー用にコピーした文字列を使い回す
+// （容量が足りなければその文字列だけ伸ばす）。同じキーを何度更新しても
+// 保持する文字列はキーごとに1つで、メモリは増え続けない。その代わり、
+// 上書き前に get で受け取った string_view は無効になる。
+//
+// 透過的な unordered_map の検索を使うため C++20 でビルドする。
+
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+namespace config {
+
+// std::string / const char* / string_view を同じハッシュで扱う
+// noexcept を付けないのは意図的。libstdc++ は noexcept なハッシュを
+// 「安い」とみなしてノードにハッシュ値を保存せず、再ハッシュや検索のたびに
+// キー文字列を読み直すので、キーが多いと大きく遅くなる
+struct StringHash {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>{}(text);
+  }
+};
+
+class ConfigParser {
+ public:
+  ConfigParser() = default;
+  ConfigParser(const ConfigParser&) = delete;
+  ConfigParser& operator=(const ConfigParser&) = delete;
+
+  // キーと値をコピーして保持する（上書きではキーごとの文字列を使い回す）
+  void set(std::string_view key, std::string_view value) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      std::string& owned = storage_.emplace_back(value);
+      auto inserted =
+          entries_.try_emplace(storage_.emplace_back(key), owned).first;
+      inserted->second.owned = &owned;
+      return;
+    }
+    Entry& entry = it->second;
+    if (entry.owned == nullptr) {
+      entry.owned = &storage_.emplace_back();
+    }
+    entry.owned->assign(value);
+    entry.reset(*entry.owned);
+  }
+
+  // キーに対応する値（コピーしない。そのキーを set で上書きするまで有効）
+  std::optional<std::string_view> get(std::string_view key) const {
+    if (Entry* entry = find(key)) {
+      return entry->value;
+    }
+    return std::nullopt;
+  }
+
+  std::optional<int> get_int(std::string_view key) const {
+    return get_cached<int>(key, kInt, &Entry::int_value,
+                           [](std::string_view text, int& out) {
+                             return parse_number(text, out);
+                           });
+  }
+
+  std::optional<double> get_double(std::string_view key) const {
+    return get_cached<double>(key, kDouble, &Entry::double_value,
+                              [](std::string_view text, double& out) {
+                                return parse_number(text, out);
+                              });
+  }
+
+  std::optional<bool> get_bool(std::string_view key) const {
+    return get_cached<bool>(key, kBool, &Entry::bool_value,
+                            [](std::string_view text, bool& out) {
+                              if (text == "true") {
+                                out = true;
+                                return true;
+                              }
+                              if (text == "false") {
+                                out = false;
+                                return true;
+                              }
+                              return false;
+                            });
+  }
+
+  bool contains(std::string_view key) const { return find(key) != nullptr; }
+  size_t size() const { return entries_.size(); }
+
+  void clear() {
+    entries_.clear();
+    storage_.clear();
+  }
+
+ protected:
+  // key / value が指す文字列はコピーしない（呼び出し側が寿命を保証する）
+  void set_view(std::string_view key, std::string_view value) {
+    auto [it, inserted] = entries_.try_emplace(key, value);
+    if (!inserted) {
+      it->second.reset(value);
+    }
+  }
+
+  void reserve(size_t count) { entries_.reserve(count); }
+
+ private:
+  // キャッシュの状態ビット（型ごとに「変換済み」と「変換成功」）
+  enum : uint8_t {
+    kInt = 1 << 0,
+    kDouble = 1 << 1,
+    kBool = 1 << 2,
+  };
+
+  struct Entry {
+    explicit Entry(std::string_view text) : value(text) {}
+
+    void reset(std::string_view text) {
+      value = text;
+      parsed.store(0, std::memory_order_relaxed);
+      valid.store(0, std::memory_order_relaxed);
+    }
+
+    std::string_view value;
+    std::string* owned = nullptr;  // set() でコピーした値（storage_ の要素）
+    std::atomic<uint8_t> parsed{0};
+    std::atomic<uint8_t> valid{0};
+    std::atomic<int> int_value{0};
+    std::atomic<double> double_value{0.0};
+    std::atomic<bool> bool_value{false};
+  };
+
+  Entry* find(std::string_view key) const {
+    auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : &it->second;
+  }
+
+  // 文字列全体が数値として読めたときだけ成功（"123abc" や " 1" は失敗）
+  template <typename T>
+  static bool parse_number(std::string_view text, T& out) {
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, out);
+    return ec == std::errc() && ptr == end;
+  }
+
+  template <typename T, typename Parse>
+  std::optional<T> get_cached(std::string_view key, uint8_t bit,
+                              std::atomic<T> Entry::*slot,
+                              Parse&& parse) const {
+    Entry* entry = find(key);
+    if (entry == nullptr) {
+      return std::nullopt;
+    }
+    // 変換済みなら値を読むだけ（acquire で値の書き込みが見える）
+    if (entry->parsed.load(std::memory_order_acquire) & bit) {
+      if (entry->valid.load(std::memory_order_relaxed) & bit) {
+        return (entry->*slot).load(std::memory_order_relaxed);
+      }
+      return std::nullopt;
+    }
+
+    T value{};
+    bool ok = parse(entry->value, value);
+    if (ok) {
+      (entry->*slot).store(value, std::memory_order_relaxed);
+      entry->valid.fetch_or(bit, std::memory_order_relaxed);
+    }
+    entry->parsed.fetch_or(bit, std::memory_order_release);
+    return ok ? std::optional<T>(value) : std::nullopt;
+  }
+
+  // get 系（const）からキャッシュを書き込むため mutable
+  mutable std::unordered_map<std::string_view, Entry, StringHash,
+                             std::equal_to<>>
+      entries_;
+  // set() でコピーしたキーと値（deque なので追加しても既存の要素は動かない）。
+  // 値はキーごとに1つで、上書きでは Entry::owned を書き換える
+  std::deque<std::string> storage_;
+};
+
+}  // namespace config
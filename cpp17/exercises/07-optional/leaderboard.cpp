@@ -0,0 +1,243 @@
+// leaderboard.h のサンプルとベンチマーク
+//   - rank_of / player_at_rank / top_k / players_in_score_range
+//   - 全件を並べ直す素朴な方法との比較（1千万人）
+//   - 更新中のスナップショット読み取り
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "leaderboard.h"
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 順位の問い合わせ ===" << std::endl;
+
+  game::Leaderboard board;
+  board.assign({{1, "Alice", 95}, {2, "Bob", 87}, {3, "Charlie", 92},
+                {4, "Dave", 87}, {5, "Eve", 70}});
+
+  std::cout << "Bob の順位: " << board.rank_of(2).value_or(0) << std::endl;
+  if (auto standing = board.player_at_rank(2)) {
+    std::cout << "2位: id=" << standing->id << " (" << standing->score << ")"
+              << std::endl;
+  }
+
+  // スナップショットを持っている間は、更新があっても内容は変わらない
+  auto before = board.snapshot();
+  board.set_score(5, 99);
+  board.erase(3);
+
+  std::cout << "更新前の上位3人:";
+  for (const auto& standing : before->top_k(3)) {
+    std::cout << " " << standing.rank << "位 id=" << standing.id << "("
+              << standing.score << ")";
+  }
+  std::cout << std::endl << "更新後の上位3人:";
+  for (const auto& standing : board.top_k(3)) {
+    std::cout << " " << standing.rank << "位 id=" << standing.id << "("
+              << standing.score << ")";
+  }
+  std::cout << std::endl << "80〜95 点:";
+  for (const auto& standing : board.players_in_score_range(80, 95)) {
+    std::cout << " " << standing.rank << "位 id=" << standing.id << "("
+              << standing.score << ")";
+  }
+  std::cout << std::endl << std::endl;
+}
+
+// ============================================================================
+// 2. 素朴な実装との照合
+// ============================================================================
+
+void verify_example() {
+  std::cout << "=== ランダムな更新で素朴な実装と照合 ===" << std::endl;
+
+  game::Leaderboard board;
+  std::map<int, int> scores;
+  std::mt19937 rng(7);
+  size_t mismatches = 0;
+  for (int step = 0; step < 20000; ++step) {
+    int id = static_cast<int>(rng() % 3000);
+    if (rng() % 4 == 0) {
+      board.erase(id);
+      scores.erase(id);
+    } else {
+      int score = static_cast<int>(rng() % 500) - 100;
+      board.set_score(id, score);
+      scores[id] = score;
+    }
+
+    if (step % 500 != 0) {
+      continue;
+    }
+    std::vector<game::Standing> expected;
+    for (const auto& [player_id, score] : scores) {
+      expected.push_back({player_id, score, 0});
+    }
+    std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+      return a.score != b.score ? a.score > b.score : a.id < b.id;
+    });
+
+    auto snapshot = board.snapshot();
+    mismatches += snapshot->size() != expected.size();
+    for (size_t i = 0; i < expected.size(); ++i) {
+      auto at = snapshot->player_at_rank(i + 1);
+      mismatches += !at || at->id != expected[i].id;
+      mismatches += snapshot->rank_of(expected[i].id) != i + 1;
+    }
+    auto range = snapshot->players_in_score_range(0, 200);
+    size_t in_range = static_cast<size_t>(
+        std::count_if(expected.begin(), expected.end(), [](const auto& s) {
+          return s.score >= 0 && s.score <= 200;
+        }));
+    mismatches += range.size() != in_range;
+  }
+  std::cout << "不一致: " << mismatches << std::endl << std::endl;
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+void run_benchmark(const char* label, int iterations, Func&& func) {
+  long long checksum = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    checksum += func(i);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << label << ": " << elapsed.count() / iterations
+            << " ns/回 (checksum " << checksum << ")" << std::endl;
+}
+
+void benchmark_example() {
+  constexpr int kPlayers = 10000000;
+  constexpr int kMaxScore = 1000000;
+  std::cout << "=== ベンチマーク（" << kPlayers << " 人）===" << std::endl;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> score_dist(0, kMaxScore);
+  std::vector<game::Player> players;
+  players.reserve(kPlayers);
+  for (int i = 0; i < kPlayers; ++i) {
+    players.push_back({i, {}, score_dist(rng)});
+  }
+
+  game::Leaderboard board;
+  auto begin = std::chrono::steady_clock::now();
+  board.assign(players);
+  std::chrono::duration<double, std::milli> build =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << "構築: " << build.count() << " ms" << std::endl;
+
+  auto random_id = [&] { return static_cast<int>(rng() % kPlayers); };
+
+  // 素朴な方法: 順位を求めるたびに自分より上の人数を数える（O(n)）
+  run_benchmark("素朴な rank_of（全件走査）       ", 20, [&](int) {
+    const game::Player& me = players[static_cast<size_t>(random_id())];
+    return static_cast<long long>(std::count_if(
+        players.begin(), players.end(), [&](const game::Player& p) {
+          return p.score > me.score || (p.score == me.score && p.id < me.id);
+        }));
+  });
+  run_benchmark("素朴な top_k(100)（partial_sort）", 5, [&](int) {
+    std::vector<game::Player> top(100);
+    std::partial_sort_copy(players.begin(), players.end(), top.begin(),
+                           top.end(), [](const auto& a, const auto& b) {
+                             return a.score != b.score ? a.score > b.score
+                                                       : a.id < b.id;
+                           });
+    return static_cast<long long>(top[0].score);
+  });
+
+  auto snapshot = board.snapshot();
+  run_benchmark("rank_of                          ", 1000000, [&](int) {
+    return static_cast<long long>(*snapshot->rank_of(random_id()));
+  });
+  run_benchmark("player_at_rank                   ", 1000000, [&](int) {
+    return static_cast<long long>(
+        snapshot->player_at_rank(1 + rng() % kPlayers)->score);
+  });
+  run_benchmark("top_k(100)                       ", 100000, [&](int) {
+    return static_cast<long long>(snapshot->top_k(100).back().score);
+  });
+  run_benchmark("players_in_score_range(幅 100)   ", 100000, [&](int) {
+    int low = score_dist(rng);
+    return static_cast<long long>(
+        snapshot->players_in_score_range(low, low + 100).size());
+  });
+  snapshot.reset();
+
+  run_benchmark("set_score（1件ごとに公開）       ", 200000, [&](int) {
+    board.set_score(random_id(), score_dist(rng));
+    return 1LL;
+  });
+  std::vector<std::pair<int, int>> batch(1000);
+  run_benchmark("set_scores（1000件ごとに公開）   ", 200, [&](int) {
+    for (auto& update : batch) {
+      update = {random_id(), score_dist(rng)};
+    }
+    board.set_scores(batch);
+    return static_cast<long long>(batch.size());
+  });
+
+  // 読み取りスレッドがスナップショットを使い続けていても更新は止まらない
+  std::atomic<bool> stop{false};
+  std::atomic<long long> reads{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; ++t) {
+    readers.emplace_back([&, t] {
+      std::mt19937 local(static_cast<unsigned>(t));
+      long long count = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto view = board.snapshot();
+        for (int i = 0; i < 100; ++i) {
+          count += view->rank_of(static_cast<int>(local() % kPlayers)) ? 1 : 0;
+        }
+      }
+      reads.fetch_add(count);
+    });
+  }
+  auto concurrent_begin = std::chrono::steady_clock::now();
+  int updates = 0;
+  while (std::chrono::steady_clock::now() - concurrent_begin <
+         std::chrono::seconds(1)) {
+    board.set_score(random_id(), score_dist(rng));
+    ++updates;
+  }
+  stop = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  std::cout << "読み取り2スレッドと並行: 1秒間に更新 " << updates
+            << " 件 / rank_of " << reads.load() << " 件（"
+            << std::thread::hardware_concurrency() << " コア）" << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "順序統計 B 木によるリーダーボードのサンプル\n" << std::endl;
+
+  basic_example();
+  verify_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,796 @@
+// 順位つきリーダーボード（順序統計 B 木 + 不変スナップショット）
+// 全プレイヤーを score で並べ直して順位を求めると、更新のたびに O(n log n)
+// かかる。ここでは
+//   - (score 降順, id 昇順) のキーを、部分木の要素数を持つ B 木（RankTree）に入れ、
+//     rank_of / player_at_rank を O(log n) で求める
+//   - id → score も同じ B 木にもう1本持ち、更新時に古いキーを引けるようにする
+//   - 木はコピーオンライトにし、更新後の根を不変スナップショットとして
+//     アトミックに公開する（02-if-init/config_store.cpp と同じ RCU 風）
+// とする。読み取り側はスナップショットを1つ取得すれば、あとはロックなしで
+// 何回でも問い合わせられ、書き込み側の更新を待たせない。
+//
+// コピーオンライトの仕組み:
+//   - ノードは作られたときの版番号を持つ。書き込み側は、まだ公開していない版の
+//     ノードだけをその場で書き換え、公開済みの版のノードは複製してから書き換える
+//     （1回の更新で複製するのは根から葉までの O(log n) ノード）
+//   - 置き換えたノードは、公開済みの最新の版の Generation に「ゴミ」として預け、
+//     その版と、それより古い版のスナップショットが全て破棄されてから解放する
+//   - 子ノードは生ポインタで持つので、複製は memcpy と同じ（shared_ptr で持つと、
+//     内部ノード1つの複製で 64 個の参照カウントを別々のキャッシュラインで
+//     更新することになる）
+//
+// 順位は 1 から数える（1位 = 最高スコア）。同点は id の小さい方が上位。
+// スナップショットは Leaderboard より長く保持しないこと。
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "player_table.h"
+
+namespace game {
+
+struct Standing {
+  int id;
+  int score;
+  size_t rank;
+};
+
+namespace detail {
+
+// ============================================================================
+// ノードと世代
+// ============================================================================
+
+constexpr size_t kRankTreeFanout = 64;
+
+// 葉は keys だけを使う。内部ノードの keys[i] は子 i の最大キー
+struct RankNode {
+  explicit RankNode(bool is_leaf) : leaf(is_leaf) {}
+
+  bool leaf;
+  uint32_t size = 0;
+  uint64_t version = 0;
+  std::array<uint64_t, kRankTreeFanout> keys{};
+};
+
+struct RankInternal : RankNode {
+  RankInternal() : RankNode(false) {}
+
+  std::array<size_t, kRankTreeFanout> counts{};  // 子 i の部分木の要素数
+  std::array<RankNode*, kRankTreeFanout> children{};
+};
+
+inline void delete_node(RankNode* node) {
+  if (node->leaf) {
+    delete node;
+  } else {
+    delete static_cast<RankInternal*>(node);
+  }
+}
+
+// 公開した版ごとに1つ。その版より後の更新で置き換えられたノードを持つ
+struct Generation {
+  std::vector<RankNode*> garbage;
+  // この版のスナップショットが全て破棄されたら true
+  mutable std::atomic<bool> released{false};
+};
+
+// 書き込み側の版番号と、置き換えたノードの預け先。
+// ゴミの解放は書き込み側が publish() のついでに行う。古い版から順に、
+// スナップショットが全て破棄された世代のゴミだけを解放する
+// （それより古いスナップショットも既に無いので、誰からも辿れない）。
+class NodeVersions {
+ public:
+  NodeVersions() = default;
+  NodeVersions(const NodeVersions&) = delete;
+  NodeVersions& operator=(const NodeVersions&) = delete;
+
+  ~NodeVersions() {
+    for (auto& generation : generations_) {
+      free_garbage(*generation);
+    }
+  }
+
+  uint64_t building() const { return building_; }
+
+  // 木から外したノードを手放す。未公開の版のノードはすぐに解放する
+  void retire(RankNode* node) {
+    if (node->version == building_) {
+      delete_node(node);
+    } else {
+      generations_.back()->garbage.push_back(node);
+    }
+  }
+
+  // 現在の版を公開済みにし、スナップショットが掴む世代を返す。
+  // 返した shared_ptr が全て破棄されると世代に released が立つ
+  std::shared_ptr<const Generation> publish() {
+    collect();
+    generations_.push_back(std::make_unique<Generation>());
+    ++building_;
+    return std::shared_ptr<const Generation>(
+        generations_.back().get(), [](const Generation* generation) {
+          generation->released.store(true, std::memory_order_release);
+        });
+  }
+
+ private:
+  static void free_garbage(Generation& generation) {
+    for (RankNode* node : generation.garbage) {
+      delete_node(node);
+    }
+    generation.garbage.clear();
+  }
+
+  void collect() {
+    while (!generations_.empty() &&
+           generations_.front()->released.load(std::memory_order_acquire)) {
+      free_garbage(*generations_.front());
+      generations_.pop_front();
+    }
+  }
+
+  uint64_t building_ = 1;
+  std::deque<std::unique_ptr<Generation>> generations_;
+};
+
+// ============================================================================
+// 部分木の要素数を持つコピーオンライト B 木（uint64_t のキーの集合）
+// ============================================================================
+
+class RankTree {
+ public:
+  using Key = uint64_t;
+  using Node = RankNode;
+  using Internal = RankInternal;
+
+  static constexpr size_t kFanout = kRankTreeFanout;
+  static constexpr size_t kMinSize = kFanout / 4;
+
+  explicit RankTree(NodeVersions& versions) : versions_(versions) {}
+  ~RankTree() {
+    if (root_ != nullptr) {
+      delete_subtree(root_);
+    }
+  }
+  RankTree(const RankTree&) = delete;
+  RankTree& operator=(const RankTree&) = delete;
+
+  // ---- 書き込み（単一スレッドから呼ぶ） ----
+
+  // key が既にあれば何もせず false
+  bool insert(Key key) {
+    if (root_ == nullptr) {
+      root_ = new_node(true);
+    }
+    if (contains(root_, key)) {
+      return false;
+    }
+    if (Node* right = insert_into(root_, key)) {
+      auto* root = static_cast<Internal*>(new_node(false));
+      root->size = 2;
+      root->children[0] = root_;
+      root->children[1] = right;
+      refresh(*root, 0);
+      refresh(*root, 1);
+      root_ = root;
+    }
+    ++size_;
+    return true;
+  }
+
+  bool erase(Key key) {
+    if (root_ == nullptr || !contains(root_, key)) {
+      return false;
+    }
+    erase_from(root_, key);
+    --size_;
+    // 根が子1つだけの内部ノードになったら1段低くする
+    while (!root_->leaf && root_->size == 1) {
+      Node* child = static_cast<Internal*>(root_)->children[0];
+      versions_.retire(root_);
+      root_ = child;
+    }
+    return true;
+  }
+
+  // ソート済み・重複なしのキー列から一括で作り直す（ノードを 3/4 だけ埋める）
+  void assign_sorted(const std::vector<Key>& keys) {
+    retire_all();
+    constexpr size_t kFill = kFanout * 3 / 4;
+    size_ = keys.size();
+    std::vector<Node*> level;
+    for (size_t begin = 0; begin < keys.size(); begin += kFill) {
+      Node* leaf = new_node(true);
+      leaf->size = static_cast<uint32_t>(std::min(kFill, keys.size() - begin));
+      std::copy_n(keys.begin() + begin, leaf->size, leaf->keys.begin());
+      level.push_back(leaf);
+    }
+    while (level.size() > 1) {
+      std::vector<Node*> parents;
+      for (size_t begin = 0; begin < level.size(); begin += kFill) {
+        auto* parent = static_cast<Internal*>(new_node(false));
+        parent->size =
+            static_cast<uint32_t>(std::min(kFill, level.size() - begin));
+        for (size_t i = 0; i < parent->size; ++i) {
+          parent->children[i] = level[begin + i];
+          refresh(*parent, i);
+        }
+        parents.push_back(parent);
+      }
+      level = std::move(parents);
+    }
+    root_ = level.empty() ? nullptr : level[0];
+  }
+
+  // 全ノードを手放す（公開済みのものはスナップショットが消えるまで残る）
+  void retire_all() {
+    if (root_ != nullptr) {
+      retire_subtree(root_);
+    }
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  const Node* root() const { return root_; }
+  size_t size() const { return size_; }
+
+  // ---- 読み取り（公開済みの根に対して、どのスレッドからでも呼べる） ----
+
+  static bool contains(const Node* node, Key key) {
+    auto found = lower_bound(node, key);
+    return found && *found == key;
+  }
+
+  // key 以上の最小のキー
+  static std::optional<Key> lower_bound(const Node* node, Key key) {
+    if (node == nullptr) {
+      return std::nullopt;
+    }
+    while (!node->leaf) {
+      const auto& internal = static_cast<const Internal&>(*node);
+      node = internal.children[child_for(internal, key)];
+    }
+    const Key* end = node->keys.data() + node->size;
+    const Key* found = std::lower_bound(node->keys.data(), end, key);
+    if (found == end) {
+      return std::nullopt;
+    }
+    return *found;
+  }
+
+  // key より小さいキーの個数
+  static size_t rank(const Node* node, Key key) {
+    if (node == nullptr) {
+      return 0;
+    }
+    size_t before = 0;
+    while (!node->leaf) {
+      const auto& internal = static_cast<const Internal&>(*node);
+      size_t i = child_for(internal, key);
+      for (size_t j = 0; j < i; ++j) {
+        before += internal.counts[j];
+      }
+      node = internal.children[i];
+    }
+    const Key* begin = node->keys.data();
+    return before + static_cast<size_t>(
+                        std::lower_bound(begin, begin + node->size, key) -
+                        begin);
+  }
+
+  // 小さい方から index 番目（0 始まり）のキー。index < 要素数 であること
+  static Key select(const Node* node, size_t index) {
+    while (!node->leaf) {
+      const auto& internal = static_cast<const Internal&>(*node);
+      size_t i = 0;
+      while (index >= internal.counts[i]) {
+        index -= internal.counts[i];
+        ++i;
+      }
+      node = internal.children[i];
+    }
+    return node->keys[index];
+  }
+
+  // index 番目以降のキーを昇順に渡す。visit が false を返したら止める
+  template <typename Visit>
+  static void visit_from(const Node* node, size_t index, Visit&& visit) {
+    if (node != nullptr) {
+      visit_node(node, index, visit);
+    }
+  }
+
+ private:
+  static size_t child_for(const Internal& internal, Key key) {
+    const Key* end = internal.keys.data() + internal.size;
+    const Key* found = std::lower_bound(internal.keys.data(), end, key);
+    return found == end ? internal.size - 1u
+                        : static_cast<size_t>(found - internal.keys.data());
+  }
+
+  static size_t count(const Node& node) {
+    if (node.leaf) {
+      return node.size;
+    }
+    const auto& internal = static_cast<const Internal&>(node);
+    size_t total = 0;
+    for (size_t i = 0; i < internal.size; ++i) {
+      total += internal.counts[i];
+    }
+    return total;
+  }
+
+  // 子 i の最大キーと要素数を取り直す
+  static void refresh(Internal& parent, size_t i) {
+    const Node& child = *parent.children[i];
+    parent.keys[i] = child.keys[child.size - 1];
+    parent.counts[i] = count(child);
+  }
+
+  Node* new_node(bool leaf) {
+    Node* node = leaf ? new Node(true) : new Internal();
+    node->version = versions_.building();
+    return node;
+  }
+
+  // 公開済みの版のノードは複製してから書き換える。
+  // 親を複製した時点で子はまだ公開済みの版なので、根から順に辿れば
+  // 書き換える経路だけが複製される
+  Node* make_writable(Node*& slot) {
+    if (slot->version == versions_.building()) {
+      return slot;
+    }
+    Node* copy;
+    if (slot->leaf) {
+      copy = new Node(*slot);
+    } else {
+      copy = new Internal(static_cast<const Internal&>(*slot));
+    }
+    copy->version = versions_.building();
+    versions_.retire(slot);
+    slot = copy;
+    return copy;
+  }
+
+  static void delete_subtree(Node* node) {
+    if (!node->leaf) {
+      auto* internal = static_cast<Internal*>(node);
+      for (size_t i = 0; i < internal->size; ++i) {
+        delete_subtree(internal->children[i]);
+      }
+    }
+    delete_node(node);
+  }
+
+  void retire_subtree(Node* node) {
+    if (!node->leaf) {
+      auto* internal = static_cast<Internal*>(node);
+      for (size_t i = 0; i < internal->size; ++i) {
+        retire_subtree(internal->children[i]);
+      }
+    }
+    versions_.retire(node);
+  }
+
+  // [pos, size) を n 個後ろへずらす
+  static void open_gap(Node& node, size_t pos, size_t n) {
+    std::copy_backward(node.keys.begin() + pos, node.keys.begin() + node.size,
+                       node.keys.begin() + node.size + n);
+    if (!node.leaf) {
+      auto& internal = static_cast<Internal&>(node);
+      std::copy_backward(internal.counts.begin() + pos,
+                         internal.counts.begin() + node.size,
+                         internal.counts.begin() + node.size + n);
+      std::copy_backward(internal.children.begin() + pos,
+                         internal.children.begin() + node.size,
+                         internal.children.begin() + node.size + n);
+    }
+    node.size += static_cast<uint32_t>(n);
+  }
+
+  // [pos, pos + n) を取り除いて前へ詰める
+  static void close_gap(Node& node, size_t pos, size_t n) {
+    std::copy(node.keys.begin() + pos + n, node.keys.begin() + node.size,
+              node.keys.begin() + pos);
+    if (!node.leaf) {
+      auto& internal = static_cast<Internal&>(node);
+      std::copy(internal.counts.begin() + pos + n,
+                internal.counts.begin() + node.size,
+                internal.counts.begin() + pos);
+      std::copy(internal.children.begin() + pos + n,
+                internal.children.begin() + node.size,
+                internal.children.begin() + pos);
+    }
+    node.size -= static_cast<uint32_t>(n);
+  }
+
+  // src の [src_pos, src_pos + n) を dst の dst_pos 以降へ写す（size は変えない）
+  static void transfer(Node& dst, size_t dst_pos, const Node& src,
+                       size_t src_pos, size_t n) {
+    std::copy_n(src.keys.begin() + src_pos, n, dst.keys.begin() + dst_pos);
+    if (!src.leaf) {
+      const auto& from = static_cast<const Internal&>(src);
+      auto& to = static_cast<Internal&>(dst);
+      std::copy_n(from.counts.begin() + src_pos, n,
+                  to.counts.begin() + dst_pos);
+      std::copy_n(from.children.begin() + src_pos, n,
+                  to.children.begin() + dst_pos);
+    }
+  }
+
+  // 満杯のノードを半分に分け、右半分を返す
+  Node* split(Node& node) {
+    Node* right = new_node(node.leaf);
+    size_t half = node.size / 2;
+    size_t moved = node.size - half;
+    transfer(*right, 0, node, half, moved);
+    right->size = static_cast<uint32_t>(moved);
+    node.size = static_cast<uint32_t>(half);
+    return right;
+  }
+
+  // 分割が起きたら右側の新しいノードを返す
+  Node* insert_into(Node*& slot, Key key) {
+    Node* node = make_writable(slot);
+    if (node->leaf) {
+      const Key* begin = node->keys.data();
+      size_t pos = static_cast<size_t>(
+          std::lower_bound(begin, begin + node->size, key) - begin);
+      open_gap(*node, pos, 1);
+      node->keys[pos] = key;
+    } else {
+      auto& internal = static_cast<Internal&>(*node);
+      size_t i = child_for(internal, key);
+      if (Node* right = insert_into(internal.children[i], key)) {
+        open_gap(internal, i + 1, 1);
+        internal.children[i + 1] = right;
+        refresh(internal, i);
+        refresh(internal, i + 1);
+      } else {
+        ++internal.counts[i];
+        internal.keys[i] = std::max(internal.keys[i], key);
+      }
+    }
+    return node->size < kFanout ? nullptr : split(*node);
+  }
+
+  // key は存在すること
+  void erase_from(Node*& slot, Key key) {
+    Node* node = make_writable(slot);
+    if (node->leaf) {
+      const Key* begin = node->keys.data();
+      size_t pos = static_cast<size_t>(
+          std::lower_bound(begin, begin + node->size, key) - begin);
+      close_gap(*node, pos, 1);
+      return;
+    }
+
+    auto& internal = static_cast<Internal&>(*node);
+    size_t i = child_for(internal, key);
+    erase_from(internal.children[i], key);
+    if (internal.children[i]->size == 0) {
+      versions_.retire(internal.children[i]);
+      close_gap(internal, i, 1);
+      return;
+    }
+    refresh(internal, i);
+    if (internal.children[i]->size < kMinSize && internal.size > 1) {
+      rebalance(internal, i);
+    }
+  }
+
+  // 子 i が少なくなったので、隣と併合するか要素を分け合う
+  void rebalance(Internal& parent, size_t i) {
+    size_t left_index = i + 1 < parent.size ? i : i - 1;
+    Node& left = *make_writable(parent.children[left_index]);
+    size_t total = left.size + parent.children[left_index + 1]->size;
+
+    if (total < kFanout) {
+      // 右は読むだけなので複製せず、そのまま手放す
+      Node* right = parent.children[left_index + 1];
+      transfer(left, left.size, *right, 0, right->size);
+      left.size = static_cast<uint32_t>(total);
+      close_gap(parent, left_index + 1, 1);
+      versions_.retire(right);
+      refresh(parent, left_index);
+      return;
+    }
+
+    Node& right = *make_writable(parent.children[left_index + 1]);
+    size_t target = total / 2;
+    if (left.size > target) {
+      size_t n = left.size - target;
+      open_gap(right, 0, n);
+      transfer(right, 0, left, target, n);
+      left.size = static_cast<uint32_t>(target);
+    } else {
+      size_t n = target - left.size;
+      transfer(left, left.size, right, 0, n);
+      left.size = static_cast<uint32_t>(target);
+      close_gap(right, 0, n);
+    }
+    refresh(parent, left_index);
+    refresh(parent, left_index + 1);
+  }
+
+  template <typename Visit>
+  static bool visit_node(const Node* node, size_t& skip, Visit& visit) {
+    if (node->leaf) {
+      if (skip >= node->size) {
+        skip -= node->size;
+        return true;
+      }
+      for (size_t i = skip; i < node->size; ++i) {
+        if (!visit(node->keys[i])) {
+          return false;
+        }
+      }
+      skip = 0;
+      return true;
+    }
+    const auto& internal = static_cast<const Internal&>(*node);
+    for (size_t i = 0; i < internal.size; ++i) {
+      if (skip >= internal.counts[i]) {
+        skip -= internal.counts[i];
+        continue;
+      }
+      if (!visit_node(internal.children[i], skip, visit)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  NodeVersions& versions_;
+  Node* root_ = nullptr;
+  size_t size_ = 0;
+};
+
+// (score 降順, id 昇順) に並ぶキー
+inline RankTree::Key score_key(int score, int id) {
+  uint32_t high = ~(static_cast<uint32_t>(score) ^ 0x80000000u);
+  uint32_t low = static_cast<uint32_t>(id) ^ 0x80000000u;
+  return (static_cast<RankTree::Key>(high) << 32) | low;
+}
+
+// id 昇順に並び、下位 32 ビットに score を持つキー
+inline RankTree::Key id_key(int id, int score) {
+  uint32_t high = static_cast<uint32_t>(id) ^ 0x80000000u;
+  return (static_cast<RankTree::Key>(high) << 32) |
+         static_cast<uint32_t>(score);
+}
+
+inline int key_high_id(RankTree::Key key) {
+  return static_cast<int>(static_cast<uint32_t>(key >> 32) ^ 0x80000000u);
+}
+
+inline int score_key_score(RankTree::Key key) {
+  return static_cast<int>(~static_cast<uint32_t>(key >> 32) ^ 0x80000000u);
+}
+
+inline int score_key_id(RankTree::Key key) {
+  return static_cast<int>(static_cast<uint32_t>(key) ^ 0x80000000u);
+}
+
+inline int id_key_score(RankTree::Key key) {
+  return static_cast<int>(static_cast<uint32_t>(key));
+}
+
+}  // namespace detail
+
+// ============================================================================
+// 読み取り専用のスナップショット
+// ============================================================================
+
+class LeaderboardSnapshot {
+ public:
+  size_t size() const { return size_; }
+
+  std::optional<int> score_of(int id) const {
+    auto key = detail::RankTree::lower_bound(by_id_, detail::id_key(id, 0));
+    if (!key || detail::key_high_id(*key) != id) {
+      return std::nullopt;
+    }
+    return detail::id_key_score(*key);
+  }
+
+  std::optional<size_t> rank_of(int id) const {
+    auto score = score_of(id);
+    if (!score) {
+      return std::nullopt;
+    }
+    return detail::RankTree::rank(by_score_, detail::score_key(*score, id)) +
+           1;
+  }
+
+  std::optional<Standing> player_at_rank(size_t rank) const {
+    if (rank == 0 || rank > size_) {
+      return std::nullopt;
+    }
+    return to_standing(detail::RankTree::select(by_score_, rank - 1), rank);
+  }
+
+  std::vector<Standing> top_k(size_t k) const {
+    std::vector<Standing> result;
+    result.reserve(std::min(k, size_));
+    detail::RankTree::visit_from(by_score_, 0, [&](detail::RankTree::Key key) {
+      if (result.size() == k) {
+        return false;
+      }
+      result.push_back(to_standing(key, result.size() + 1));
+      return true;
+    });
+    return result;
+  }
+
+  // min_score <= score <= max_score の人を順位順に返す
+  std::vector<Standing> players_in_score_range(int min_score,
+                                               int max_score) const {
+    std::vector<Standing> result;
+    if (min_score > max_score) {
+      return result;
+    }
+    detail::RankTree::Key first = detail::score_key(max_score, INT32_MIN);
+    size_t rank = detail::RankTree::rank(by_score_, first) + 1;
+    detail::RankTree::visit_from(
+        by_score_, rank - 1, [&](detail::RankTree::Key key) {
+          if (detail::score_key_score(key) < min_score) {
+            return false;
+          }
+          result.push_back(to_standing(key, rank++));
+          return true;
+        });
+    return result;
+  }
+
+ private:
+  friend class Leaderboard;
+
+  static Standing to_standing(detail::RankTree::Key key, size_t rank) {
+    return {detail::score_key_id(key), detail::score_key_score(key), rank};
+  }
+
+  // generation_ を持っている間、by_score_ / by_id_ から辿れるノードは解放されない
+  std::shared_ptr<const detail::Generation> generation_;
+  const detail::RankNode* by_score_ = nullptr;
+  const detail::RankNode* by_id_ = nullptr;
+  size_t size_ = 0;
+};
+
+// ============================================================================
+// リーダーボード
+// ============================================================================
+
+class Leaderboard {
+ public:
+  using SnapshotPtr = std::shared_ptr<const LeaderboardSnapshot>;
+
+  Leaderboard() : by_score_(versions_), by_id_(versions_) { publish(); }
+
+  Leaderboard(const Leaderboard&) = delete;
+  Leaderboard& operator=(const Leaderboard&) = delete;
+
+  // まとめて登録し直す。id が重複した場合は先に現れたものを残す
+  void assign(const std::vector<Player>& players) {
+    std::vector<detail::RankTree::Key> ids;
+    ids.reserve(players.size());
+    for (const Player& player : players) {
+      ids.push_back(detail::id_key(player.id, player.score));
+    }
+    auto same_id = [](detail::RankTree::Key a, detail::RankTree::Key b) {
+      return detail::key_high_id(a) == detail::key_high_id(b);
+    };
+    std::stable_sort(ids.begin(), ids.end(),
+                     [](detail::RankTree::Key a, detail::RankTree::Key b) {
+                       return (a >> 32) < (b >> 32);
+                     });
+    ids.erase(std::unique(ids.begin(), ids.end(), same_id), ids.end());
+
+    std::vector<detail::RankTree::Key> scores;
+    scores.reserve(ids.size());
+    for (detail::RankTree::Key key : ids) {
+      scores.push_back(detail::score_key(detail::id_key_score(key),
+                                         detail::key_high_id(key)));
+    }
+    std::sort(scores.begin(), scores.end());
+
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    by_id_.assign_sorted(ids);
+    by_score_.assign_sorted(scores);
+    publish();
+  }
+
+  // 登録または score の更新
+  void set_score(int id, int score) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    apply(id, score);
+    publish();
+  }
+
+  // (id, score) の列をまとめて反映し、スナップショットの公開を1回で済ませる
+  // （同じノードへの2回目以降の書き換えは複製なしになる）
+  void set_scores(const std::vector<std::pair<int, int>>& updates) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    for (const auto& [id, score] : updates) {
+      apply(id, score);
+    }
+    publish();
+  }
+
+  bool erase(int id) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    auto old = detail::RankTree::lower_bound(by_id_.root(),
+                                             detail::id_key(id, 0));
+    if (!old || detail::key_high_id(*old) != id) {
+      return false;
+    }
+    by_id_.erase(*old);
+    by_score_.erase(detail::score_key(detail::id_key_score(*old), id));
+    publish();
+    return true;
+  }
+
+  // 最新のスナップショット。保持している間は内容が変わらない
+  SnapshotPtr snapshot() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+  }
+
+  // 1回だけ問い合わせる場合の簡易版（毎回スナップショットを取得する）
+  std::optional<size_t> rank_of(int id) const {
+    return snapshot()->rank_of(id);
+  }
+  std::optional<Standing> player_at_rank(size_t rank) const {
+    return snapshot()->player_at_rank(rank);
+  }
+  std::vector<Standing> top_k(size_t k) const { return snapshot()->top_k(k); }
+  std::vector<Standing> players_in_score_range(int min_score,
+                                               int max_score) const {
+    return snapshot()->players_in_score_range(min_score, max_score);
+  }
+
+ private:
+  void apply(int id, int score) {
+    auto old = detail::RankTree::lower_bound(by_id_.root(),
+                                             detail::id_key(id, 0));
+    if (old && detail::key_high_id(*old) == id) {
+      if (detail::id_key_score(*old) == score) {
+        return;
+      }
+      by_id_.erase(*old);
+      by_score_.erase(detail::score_key(detail::id_key_score(*old), id));
+    }
+    by_id_.insert(detail::id_key(id, score));
+    by_score_.insert(detail::score_key(score, id));
+  }
+
+  void publish() {
+    auto next = std::make_shared<LeaderboardSnapshot>();
+    next->by_score_ = by_score_.root();
+    next->by_id_ = by_id_.root();
+    next->size_ = by_score_.size();
+    next->generation_ = versions_.publish();
+    std::atomic_store_explicit(&current_, SnapshotPtr(std::move(next)),
+                               std::memory_order_release);
+  }
+
+  // versions_ は木より先に作り、木とスナップショットより後に壊す
+  detail::NodeVersions versions_;
+  detail::RankTree by_score_;
+  detail::RankTree by_id_;
+  SnapshotPtr current_;
+  std::mutex write_mutex_;
+};
+
+}  // namespace game
@@ -0,0 +1,154 @@
+// niche_optional.h のサンプルとベンチマーク
+//   - int / double / ポインタ / 任意のニッチ
+//   - 1千万要素の配列で std::optional とメモリ量・走査時間を比べる
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "niche_optional.h"
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+compact::NicheOptional<int> find_index(const std::vector<int>& values,
+                                       int target) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i] == target) {
+      return static_cast<int>(i);
+    }
+  }
+  return std::nullopt;
+}
+
+void basic_example() {
+  std::cout << "=== ニッチで空を表す optional ===" << std::endl;
+
+  std::cout << "sizeof: std::optional<int>=" << sizeof(std::optional<int>)
+            << " NicheOptional<int>=" << sizeof(compact::NicheOptional<int>)
+            << " / std::optional<double>=" << sizeof(std::optional<double>)
+            << " NicheOptional<double>="
+            << sizeof(compact::NicheOptional<double>) << std::endl;
+
+  std::vector<int> values = {4, 8, 15, 16, 23, 42};
+  if (auto index = find_index(values, 15)) {
+    std::cout << "15 の位置: " << *index << std::endl;
+  }
+  std::cout << "99 の位置: " << find_index(values, 99).value_or(-1) << std::endl;
+
+  // 普通の NaN は値として入れられる（ニッチは別のビット列）
+  compact::NicheOptional<double> reading = std::nan("");
+  std::cout << "NaN を入れた: has_value=" << reading.has_value() << std::endl;
+  reading.reset();
+  std::cout << "reset 後: has_value=" << reading.has_value() << std::endl;
+
+  // -1 を「なし」に使う既存の API に合わせる
+  using Slot = compact::NicheOptional<int, compact::NicheValue<int, -1>>;
+  Slot slot;
+  std::cout << "Slot: " << (slot ? "あり" : "なし");
+  slot = 3;
+  std::cout << " -> " << *slot << std::endl;
+
+  int target = 7;
+  compact::NicheOptional<int*> pointer = &target;
+  std::cout << "ポインタ: " << **pointer << " / std::optional へ: "
+            << pointer.to_std().has_value() << std::endl;
+
+  try {
+    compact::NicheOptional<int> empty;
+    std::cout << empty.value() << std::endl;
+  } catch (const std::bad_optional_access& e) {
+    std::cout << "空の value(): " << e.what() << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+void measure(const char* label, int repeats, Func&& func) {
+  double result = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; ++i) {
+    result += func();
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << "  " << label << ": " << elapsed.count() / repeats
+            << " ms/回 (checksum " << result << ")" << std::endl;
+}
+
+// 7割に値がある配列を作り、値の合計を求める
+template <typename Optional, typename T>
+void benchmark_array(const char* name, size_t count, T scale) {
+  std::vector<Optional> values(count);
+  std::cout << "  " << name << ": " << sizeof(Optional) << " バイト × " << count
+            << " = " << sizeof(Optional) * count / (1 << 20) << " MB"
+            << std::endl;
+
+  measure("書き込み", 5, [&] {
+    for (size_t i = 0; i < count; ++i) {
+      if ((static_cast<uint32_t>(i) * 2654435761u >> 8) % 10 < 7) {
+        values[i] = static_cast<T>(i % 1000) * scale;
+      } else {
+        values[i] = std::nullopt;
+      }
+    }
+    return 0.0;
+  });
+  using Sum = std::conditional_t<std::is_integral_v<T>, long long, double>;
+  measure("合計    ", 20, [&] {
+    Sum sum = 0;
+    for (const auto& value : values) {
+      if (value) {
+        sum += *value;
+      }
+    }
+    return static_cast<double>(sum);
+  });
+  measure("value_or", 20, [&] {
+    Sum sum = 0;
+    for (const auto& value : values) {
+      sum += value.value_or(T{0});
+    }
+    return static_cast<double>(sum);
+  });
+}
+
+void benchmark_example() {
+  constexpr size_t kCount = 10000000;
+  std::cout << "=== ベンチマーク（" << kCount << " 要素）===" << std::endl;
+
+  std::cout << "[int]" << std::endl;
+  benchmark_array<std::optional<int>, int>("std::optional<int>    ", kCount, 1);
+  benchmark_array<compact::NicheOptional<int>, int>("NicheOptional<int>    ",
+                                                    kCount, 1);
+  std::cout << "[double]" << std::endl;
+  benchmark_array<std::optional<double>, double>("std::optional<double> ",
+                                                 kCount, 0.5);
+  benchmark_array<compact::NicheOptional<double>, double>(
+      "NicheOptional<double> ", kCount, 0.5);
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "ニッチ最適化した optional のサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
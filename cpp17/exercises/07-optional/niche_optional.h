@@ -0,0 +1,163 @@
+// 「空」を値の中の使わない値（ニッチ）で表す optional
+// std::optional<T> は T の後ろに bool を1つ持つので、T のアラインメントまで
+// 切り上げられて std::optional<int> は 8 バイト、std::optional<double> は 16 バイトになる。
+// 1千万要素の配列では、読み書きするバイト数がそのまま倍になる。
+// ここでは T の中で決して使わない値を1つ決め、それを「空」とみなすことで
+// sizeof(NicheOptional<T>) == sizeof(T) にする。
+//
+// ニッチの既定値（NicheTraits<T>）:
+//   - 符号付き整数: 最小値（INT_MIN など）
+//   - 符号なし整数: 最大値
+//   - bool: なし（true / false の両方を使うので空く値がない。std::optional<bool> を使う）
+//   - ポインタ: nullptr
+//   - float / double: 特定のビット列の NaN（普通の NaN は値として入れられる）
+// 別の値を使うときは NicheValue<T, 値> を渡す（例: NicheOptional<int, NicheValue<int, -1>>）。
+// ニッチの値そのものを「値」として入れることはできない（デバッグビルドでは assert）。
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace compact {
+
+// ============================================================================
+// ニッチの決め方
+// ============================================================================
+
+template <typename T, typename Enable = void>
+struct NicheTraits;
+
+// bool は符号なしなので最大値 true がニッチになってしまう。対象から外す
+template <typename T>
+struct NicheTraits<
+    T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+  static constexpr T empty_value() {
+    return std::is_signed_v<T> ? std::numeric_limits<T>::min()
+                               : std::numeric_limits<T>::max();
+  }
+  static constexpr bool is_empty(T value) { return value == empty_value(); }
+};
+
+template <typename T>
+struct NicheTraits<T*> {
+  static constexpr T* empty_value() { return nullptr; }
+  static constexpr bool is_empty(T* value) { return value == nullptr; }
+};
+
+// 浮動小数点は NaN 同士が等しくならないので、ビット列で比べる
+template <typename T>
+struct NicheTraits<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "float / double のみ");
+  using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  // 仮数部に目印を入れた quiet NaN（演算で自然に出てくる NaN とは別のビット列）
+  static constexpr Bits kBits =
+      sizeof(T) == 4 ? Bits{0x7FC0'DEADu} : Bits{0x7FF8'0000'DEAD'BEEFull};
+
+  static T empty_value() {
+    T value;
+    std::memcpy(&value, &kBits, sizeof(T));
+    return value;
+  }
+  static bool is_empty(T value) {
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits == kBits;
+  }
+};
+
+// 任意の値をニッチにする（整数・列挙型など）
+template <typename T, T kValue>
+struct NicheValue {
+  static constexpr T empty_value() { return kValue; }
+  static constexpr bool is_empty(T value) { return value == kValue; }
+};
+
+// ============================================================================
+// NicheOptional
+// ============================================================================
+
+template <typename T, typename Traits = NicheTraits<T>>
+class NicheOptional {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "ニッチで表せるのはトリビアルにコピーできる型だけ");
+  static_assert(!std::is_same_v<T, bool>,
+                "bool には空く値がないので std::optional<bool> を使う");
+
+ public:
+  using value_type = T;
+
+  constexpr NicheOptional() noexcept : value_(Traits::empty_value()) {}
+  constexpr NicheOptional(std::nullopt_t) noexcept : NicheOptional() {}
+  constexpr NicheOptional(T value) noexcept : value_(value) {
+    assert(!Traits::is_empty(value) && "ニッチの値は入れられない");
+  }
+  NicheOptional(const std::optional<T>& other) noexcept
+      : NicheOptional(other ? NicheOptional(*other) : NicheOptional()) {}
+
+  NicheOptional& operator=(std::nullopt_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  constexpr bool has_value() const noexcept {
+    return !Traits::is_empty(value_);
+  }
+  constexpr explicit operator bool() const noexcept { return has_value(); }
+
+  constexpr const T& operator*() const noexcept { return value_; }
+  constexpr T& operator*() noexcept { return value_; }
+  constexpr const T* operator->() const noexcept { return &value_; }
+  constexpr T* operator->() noexcept { return &value_; }
+
+  constexpr const T& value() const {
+    if (!has_value()) {
+      throw std::bad_optional_access();
+    }
+    return value_;
+  }
+
+  constexpr T value_or(T fallback) const noexcept {
+    return has_value() ? value_ : fallback;
+  }
+
+  void reset() noexcept { value_ = Traits::empty_value(); }
+
+  T& emplace(T value) noexcept {
+    assert(!Traits::is_empty(value) && "ニッチの値は入れられない");
+    value_ = value;
+    return value_;
+  }
+
+  std::optional<T> to_std() const {
+    return has_value() ? std::optional<T>(value_) : std::nullopt;
+  }
+
+  friend constexpr bool operator==(const NicheOptional& a,
+                                   const NicheOptional& b) noexcept {
+    return a.has_value() == b.has_value() &&
+           (!a.has_value() || a.value_ == b.value_);
+  }
+  friend constexpr bool operator!=(const NicheOptional& a,
+                                   const NicheOptional& b) noexcept {
+    return !(a == b);
+  }
+  friend constexpr bool operator==(const NicheOptional& a,
+                                   std::nullopt_t) noexcept {
+    return !a.has_value();
+  }
+  friend constexpr bool operator!=(const NicheOptional& a,
+                                   std::nullopt_t) noexcept {
+    return a.has_value();
+  }
+
+ private:
+  T value_;
+};
+
+}  // namespace compact
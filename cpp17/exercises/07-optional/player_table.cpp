@@ -0,0 +1,169 @@
+// player_table.h のサンプルとベンチマーク
+//   - id / score による検索と、更新・削除に追従する索引
+//   - 1千万人のテーブルで solution.cpp の線形探索と比較する
+
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "player_table.h"
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 索引つきの検索 ===" << std::endl;
+
+  game::PlayerTable table;
+  table.insert({1, "Alice", 95});
+  table.insert({2, "Bob", 87});
+  table.insert({3, "Charlie", 92});
+  std::cout << "id=1 を二重に登録: "
+            << (table.insert({1, "Alice2", 10}) ? "成功" : "失敗") << std::endl;
+
+  if (auto player = table.find(2)) {
+    std::cout << "id=2: " << player->name << " (score: " << player->score
+              << ")" << std::endl;
+  }
+  if (!table.find(999)) {
+    std::cout << "id=999 は見つかりません" << std::endl;
+  }
+
+  if (auto player = table.find_by_min_score(90)) {
+    std::cout << "score >= 90 の最小: " << player->name << " ("
+              << player->score << ")" << std::endl;
+  }
+
+  // 更新すると索引も追従する
+  table.update_score(2, 99);
+  table.erase(3);
+  std::cout << "Bob を 99 に更新し Charlie を削除した後の 90〜100:";
+  table.for_each_in_score_range(90, 100, [](const game::Player& player) {
+    std::cout << " " << player.name << "(" << player.score << ")";
+  });
+  std::cout << std::endl << std::endl;
+}
+
+// ============================================================================
+// 2. 比較用: solution.cpp と同じ線形探索
+// ============================================================================
+
+std::optional<game::Player> find_player_by_id(
+    const std::vector<game::Player>& players, int id) {
+  for (const auto& player : players) {
+    if (player.id == id) {
+      return player;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<game::Player> find_player_by_min_score(
+    const std::vector<game::Player>& players, int min_score) {
+  for (const auto& player : players) {
+    if (player.score >= min_score) {
+      return player;
+    }
+  }
+  return std::nullopt;
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+void run_benchmark(const char* label, int iterations, Func&& func) {
+  long long checksum = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    checksum += func(i);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << label << ": " << elapsed.count() / iterations
+            << " ns/回 (checksum " << checksum << ")" << std::endl;
+}
+
+void benchmark_example() {
+  constexpr int kPlayers = 10000000;
+  constexpr int kMaxScore = 1000000;
+  std::cout << "=== ベンチマーク（" << kPlayers << " 人）===" << std::endl;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> score_dist(0, kMaxScore);
+  std::vector<game::Player> players;
+  players.reserve(kPlayers);
+  for (int i = 0; i < kPlayers; ++i) {
+    // id は連番にせず散らす
+    int id = static_cast<int>((static_cast<uint32_t>(i) * 2654435761u) >> 1);
+    players.push_back({id, "player_" + std::to_string(i), score_dist(rng)});
+  }
+
+  game::PlayerTable table;
+  auto begin = std::chrono::steady_clock::now();
+  table.assign(players);
+  std::chrono::duration<double, std::milli> build =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << "索引の構築: " << build.count() << " ms" << std::endl;
+
+  std::vector<int> query_ids(1 << 20);
+  for (int& id : query_ids) {
+    id = players[static_cast<size_t>(rng()) % players.size()].id;
+  }
+  std::vector<int> query_scores(1 << 20);
+  for (int& score : query_scores) {
+    score = kMaxScore - score_dist(rng) % 1000;
+  }
+  auto query = [](const std::vector<int>& values, int i) {
+    return values[static_cast<size_t>(i) & (values.size() - 1)];
+  };
+
+  run_benchmark("線形 find_player_by_id        ", 20, [&](int i) {
+    return static_cast<long long>(
+        find_player_by_id(players, query(query_ids, i))->score);
+  });
+  run_benchmark("PlayerTable::find             ", 1000000, [&](int i) {
+    return static_cast<long long>(table.find(query(query_ids, i))->score);
+  });
+  run_benchmark("線形 find_player_by_min_score ", 200, [&](int i) {
+    return static_cast<long long>(
+        find_player_by_min_score(players, query(query_scores, i))->score);
+  });
+  run_benchmark("PlayerTable::find_by_min_score", 1000000, [&](int i) {
+    return static_cast<long long>(
+        table.find_by_min_score(query(query_scores, i))->score);
+  });
+  run_benchmark("PlayerTable::update_score     ", 1000000, [&](int i) {
+    return static_cast<long long>(
+        table.update_score(query(query_ids, i), score_dist(rng)));
+  });
+  run_benchmark("PlayerTable::erase + insert   ", 1000000, [&](int i) {
+    int id = query(query_ids, i);
+    game::Player player = *table.find(id);
+    table.erase(id);
+    return static_cast<long long>(table.insert(std::move(player)));
+  });
+  std::cout << "最終的な人数: " << table.size() << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "id と score に索引を持つプレイヤーテーブルのサンプル\n"
+            << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
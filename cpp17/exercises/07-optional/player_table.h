@@ -0,0 +1,439 @@
+// id と score に索引を持つプレイヤーテーブル
+// solution.cpp の find_player_by_id / find_player_by_min_score は
+//   - グローバルな std::vector<Player> を先頭から線形に走査し
+//   - 見つかった Player を std::optional<Player> にコピーして返す
+// ので、1千万人のテーブルでは1回の検索で数ミリ秒かかり、名前の文字列もコピーされる。
+// ここでは
+//   - プレイヤー本体は詰めた std::vector に置き、削除は末尾との入れ替えで O(1)
+//   - id → 位置 はオープンアドレス法のハッシュ表（IdIndex）で O(1)
+//   - (score, id) はブロックに分けたソート済み配列（ScoreIndex）で O(log n)
+//   - 検索結果はコピーせず、OptionalRef（参照版の optional）で返す
+// とし、insert / update_score / erase のたびに両方の索引を差分だけ更新する。
+//
+// OptionalRef はテーブルを変更すると無効になる（std::vector のイテレータと同じ）。
+// find_by_min_score は「score >= min_score の中で score が最小の人
+// （同点なら id が最小）」を返す。solution.cpp の「配列で最初に見つかった人」とは
+// 異なるが、索引から一意に決まる。
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace game {
+
+struct Player {
+  int id;
+  std::string name;
+  int score;
+};
+
+// ============================================================================
+// 所有しない optional（T* の薄いラッパー）
+// ============================================================================
+
+template <typename T>
+class OptionalRef {
+ public:
+  OptionalRef() = default;
+  OptionalRef(std::nullopt_t) {}
+  explicit OptionalRef(T& value) : pointer_(&value) {}
+
+  bool has_value() const { return pointer_ != nullptr; }
+  explicit operator bool() const { return has_value(); }
+
+  T& operator*() const { return *pointer_; }
+  T* operator->() const { return pointer_; }
+
+  T& value() const {
+    if (pointer_ == nullptr) {
+      throw std::bad_optional_access();
+    }
+    return *pointer_;
+  }
+
+ private:
+  T* pointer_ = nullptr;
+};
+
+// ============================================================================
+// id → 位置 の索引（線形探査のハッシュ表）
+// ============================================================================
+
+class IdIndex {
+ public:
+  static constexpr uint32_t kNotFound = UINT32_MAX;
+
+  IdIndex() { rehash(16); }
+
+  uint32_t find(int id) const {
+    for (size_t i = home(id);; i = (i + 1) & mask_) {
+      const Bucket& bucket = buckets_[i];
+      if (bucket.slot == kNotFound || bucket.id == id) {
+        return bucket.slot;
+      }
+    }
+  }
+
+  // 既に登録済みなら false
+  bool insert(int id, uint32_t slot) {
+    if ((size_ + 1) * 4 > buckets_.size() * 3) {
+      rehash(buckets_.size() * 2);
+    }
+    for (size_t i = home(id);; i = (i + 1) & mask_) {
+      Bucket& bucket = buckets_[i];
+      if (bucket.slot == kNotFound) {
+        bucket = {id, slot};
+        ++size_;
+        return true;
+      }
+      if (bucket.id == id) {
+        return false;
+      }
+    }
+  }
+
+  // 登録済みの id の位置を書き換える
+  void assign(int id, uint32_t slot) {
+    for (size_t i = home(id);; i = (i + 1) & mask_) {
+      if (buckets_[i].id == id && buckets_[i].slot != kNotFound) {
+        buckets_[i].slot = slot;
+        return;
+      }
+    }
+  }
+
+  // 墓標を残さず、後ろの要素を詰め直す（backward shift deletion）
+  bool erase(int id) {
+    size_t hole = home(id);
+    for (;; hole = (hole + 1) & mask_) {
+      if (buckets_[hole].slot == kNotFound) {
+        return false;
+      }
+      if (buckets_[hole].id == id) {
+        break;
+      }
+    }
+    for (size_t next = (hole + 1) & mask_;; next = (next + 1) & mask_) {
+      const Bucket& bucket = buckets_[next];
+      if (bucket.slot == kNotFound) {
+        break;
+      }
+      // 本来の位置から next までの距離が hole から next までより長ければ
+      // hole に移しても探索で見つかる
+      size_t ideal = home(bucket.id);
+      if (((next - ideal) & mask_) >= ((next - hole) & mask_)) {
+        buckets_[hole] = bucket;
+        hole = next;
+      }
+    }
+    buckets_[hole].slot = kNotFound;
+    --size_;
+    return true;
+  }
+
+  void reserve(size_t count) {
+    size_t capacity = buckets_.size();
+    while (count * 4 > capacity * 3) {
+      capacity *= 2;
+    }
+    if (capacity != buckets_.size()) {
+      rehash(capacity);
+    }
+  }
+
+  void clear() {
+    buckets_.assign(buckets_.size(), Bucket{0, kNotFound});
+    size_ = 0;
+  }
+
+ private:
+  struct Bucket {
+    int32_t id;
+    uint32_t slot;
+  };
+
+  // フィボナッチハッシュ（連番の id でも上位ビットに散らばる）
+  size_t home(int id) const {
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(static_cast<uint32_t>(id)) *
+         0x9E3779B97F4A7C15ull) >>
+        shift_);
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<Bucket> old = std::move(buckets_);
+    buckets_.assign(capacity, Bucket{0, kNotFound});
+    mask_ = capacity - 1;
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+      --shift_;
+    }
+    size_ = 0;
+    for (const Bucket& bucket : old) {
+      if (bucket.slot != kNotFound) {
+        insert(bucket.id, bucket.slot);
+      }
+    }
+  }
+
+  std::vector<Bucket> buckets_;
+  size_t mask_ = 0;
+  unsigned shift_ = 64;
+  size_t size_ = 0;
+};
+
+// ============================================================================
+// (score, id) の順序付き索引
+// ============================================================================
+
+// 1本のソート済み配列だと挿入・削除が O(n) の移動になるので、
+// 最大 kMaxBlock 要素のソート済みブロックに分ける。ブロックの最大キーを
+// 別の配列に並べておき、二分探索でブロックを選んでからブロック内を二分探索する。
+// 挿入・削除の移動量は最大 kMaxBlock 要素（8KB）で済む。
+class ScoreIndex {
+ public:
+  // score が上位 32 ビット、id が下位 32 ビット。符号ビットを反転して
+  // 符号なし整数の大小と (score, id) の辞書順を一致させる
+  using Key = uint64_t;
+
+  static Key make_key(int score, int id) {
+    return (static_cast<Key>(static_cast<uint32_t>(score) ^ 0x80000000u)
+            << 32) |
+           (static_cast<uint32_t>(id) ^ 0x80000000u);
+  }
+  static int score_of(Key key) {
+    return static_cast<int>(static_cast<uint32_t>(key >> 32) ^ 0x80000000u);
+  }
+  static int id_of(Key key) {
+    return static_cast<int>(static_cast<uint32_t>(key) ^ 0x80000000u);
+  }
+
+  void insert(Key key) {
+    if (blocks_.empty()) {
+      blocks_.emplace_back();
+      block_max_.push_back(key);
+    }
+    size_t b = std::min(find_block(key), blocks_.size() - 1);
+    std::vector<Key>& block = blocks_[b];
+    block.insert(std::lower_bound(block.begin(), block.end(), key), key);
+    block_max_[b] = block.back();
+    ++size_;
+
+    if (block.size() > kMaxBlock) {
+      std::vector<Key> upper(block.begin() + kMaxBlock / 2, block.end());
+      block.resize(kMaxBlock / 2);
+      block_max_[b] = block.back();
+      block_max_.insert(block_max_.begin() + b + 1, upper.back());
+      blocks_.insert(blocks_.begin() + b + 1, std::move(upper));
+    }
+  }
+
+  bool erase(Key key) {
+    size_t b = find_block(key);
+    if (b == blocks_.size()) {
+      return false;
+    }
+    std::vector<Key>& block = blocks_[b];
+    auto it = std::lower_bound(block.begin(), block.end(), key);
+    if (it == block.end() || *it != key) {
+      return false;
+    }
+    block.erase(it);
+    --size_;
+    if (block.empty()) {
+      blocks_.erase(blocks_.begin() + b);
+      block_max_.erase(block_max_.begin() + b);
+    } else {
+      block_max_[b] = block.back();
+    }
+    return true;
+  }
+
+  // key 以上の最小のキー
+  std::optional<Key> lower_bound(Key key) const {
+    size_t b = find_block(key);
+    if (b == blocks_.size()) {
+      return std::nullopt;
+    }
+    const std::vector<Key>& block = blocks_[b];
+    return *std::lower_bound(block.begin(), block.end(), key);
+  }
+
+  // key 以上のキーを昇順に渡す。visit が false を返したら止める
+  template <typename Visit>
+  void for_each_from(Key key, Visit&& visit) const {
+    for (size_t b = find_block(key); b < blocks_.size(); ++b) {
+      const std::vector<Key>& block = blocks_[b];
+      auto it = std::lower_bound(block.begin(), block.end(), key);
+      for (; it != block.end(); ++it) {
+        if (!visit(*it)) {
+          return;
+        }
+      }
+    }
+  }
+
+  // ソート済みのキー列から作り直す（ブロックを半分だけ埋めて挿入の余地を残す）
+  void assign_sorted(const std::vector<Key>& keys) {
+    clear();
+    for (size_t begin = 0; begin < keys.size(); begin += kMaxBlock / 2) {
+      size_t end = std::min(keys.size(), begin + kMaxBlock / 2);
+      blocks_.emplace_back(keys.begin() + begin, keys.begin() + end);
+      block_max_.push_back(keys[end - 1]);
+    }
+    size_ = keys.size();
+  }
+
+  void clear() {
+    blocks_.clear();
+    block_max_.clear();
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  static constexpr size_t kMaxBlock = 1024;
+
+  // 最大キーが key 以上の最初のブロック（なければ blocks_.size()）
+  size_t find_block(Key key) const {
+    return static_cast<size_t>(
+        std::lower_bound(block_max_.begin(), block_max_.end(), key) -
+        block_max_.begin());
+  }
+
+  std::vector<std::vector<Key>> blocks_;
+  std::vector<Key> block_max_;
+  size_t size_ = 0;
+};
+
+// ============================================================================
+// プレイヤーテーブル
+// ============================================================================
+
+class PlayerTable {
+ public:
+  // まとめて登録する（索引は1回のソートで作る）。
+  // id が重複した場合は先に現れたものを残す。登録した人数を返す
+  size_t assign(std::vector<Player> players) {
+    clear();
+    players_.reserve(players.size());
+    ids_.reserve(players.size());
+    std::vector<ScoreIndex::Key> keys;
+    keys.reserve(players.size());
+    for (Player& player : players) {
+      auto slot = static_cast<uint32_t>(players_.size());
+      if (ids_.insert(player.id, slot)) {
+        keys.push_back(ScoreIndex::make_key(player.score, player.id));
+        players_.push_back(std::move(player));
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    scores_.assign_sorted(keys);
+    return players_.size();
+  }
+
+  // id が既にあれば何もせず false
+  bool insert(Player player) {
+    auto slot = static_cast<uint32_t>(players_.size());
+    if (!ids_.insert(player.id, slot)) {
+      return false;
+    }
+    scores_.insert(ScoreIndex::make_key(player.score, player.id));
+    players_.push_back(std::move(player));
+    return true;
+  }
+
+  bool update_score(int id, int score) {
+    uint32_t slot = ids_.find(id);
+    if (slot == IdIndex::kNotFound) {
+      return false;
+    }
+    Player& player = players_[slot];
+    if (player.score != score) {
+      scores_.erase(ScoreIndex::make_key(player.score, id));
+      scores_.insert(ScoreIndex::make_key(score, id));
+      player.score = score;
+    }
+    return true;
+  }
+
+  // 名前は索引に関係しないのでそのまま書き換える
+  bool rename(int id, std::string name) {
+    uint32_t slot = ids_.find(id);
+    if (slot == IdIndex::kNotFound) {
+      return false;
+    }
+    players_[slot].name = std::move(name);
+    return true;
+  }
+
+  bool erase(int id) {
+    uint32_t slot = ids_.find(id);
+    if (slot == IdIndex::kNotFound) {
+      return false;
+    }
+    scores_.erase(ScoreIndex::make_key(players_[slot].score, id));
+    ids_.erase(id);
+
+    // 末尾の要素を空いた位置に移し、その id の位置を付け替える
+    auto last = static_cast<uint32_t>(players_.size() - 1);
+    if (slot != last) {
+      players_[slot] = std::move(players_[last]);
+      ids_.assign(players_[slot].id, slot);
+    }
+    players_.pop_back();
+    return true;
+  }
+
+  OptionalRef<const Player> find(int id) const {
+    uint32_t slot = ids_.find(id);
+    if (slot == IdIndex::kNotFound) {
+      return std::nullopt;
+    }
+    return OptionalRef<const Player>(players_[slot]);
+  }
+
+  OptionalRef<const Player> find_by_min_score(int min_score) const {
+    auto key = scores_.lower_bound(ScoreIndex::make_key(min_score, INT32_MIN));
+    if (!key) {
+      return std::nullopt;
+    }
+    return find(ScoreIndex::id_of(*key));
+  }
+
+  // min_score <= score <= max_score の人を score の昇順に渡す
+  template <typename Visit>
+  void for_each_in_score_range(int min_score, int max_score,
+                               Visit&& visit) const {
+    scores_.for_each_from(ScoreIndex::make_key(min_score, INT32_MIN),
+                          [&](ScoreIndex::Key key) {
+                            if (ScoreIndex::score_of(key) > max_score) {
+                              return false;
+                            }
+                            visit(*find(ScoreIndex::id_of(key)));
+                            return true;
+                          });
+  }
+
+  size_t size() const { return players_.size(); }
+
+  void clear() {
+    players_.clear();
+    ids_.clear();
+    scores_.clear();
+  }
+
+ private:
+  std::vector<Player> players_;
+  IdIndex ids_;
+  ScoreIndex scores_;
+};
+
+}  // namespace game
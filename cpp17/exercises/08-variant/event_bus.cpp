@@ -0,0 +1,290 @@
+// event_bus.h のサンプルとベンチマーク
+//   - 型ごとの購読と std::span でのまとめ配送
+//   - solution.cpp と同じ vector<GameEvent> + std::visit との比較
+//   - 生産スレッドと消費スレッドでフレームをずらして流す二重バッファ
+
+#include <barrier>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "event_bus.h"
+
+// ============================================================================
+// イベント型（solution.cpp と同じ）
+// ============================================================================
+
+template <class... Ts>
+struct overloaded : Ts... {
+  using Ts::operator()...;
+};
+template <class... Ts>
+overloaded(Ts...) -> overloaded<Ts...>;
+
+struct PlayerMoved {
+  float x;
+  float y;
+};
+
+struct ItemPickedUp {
+  int item_id;
+  std::string item_name;
+};
+
+struct DamageTaken {
+  int amount;
+  std::string source;
+};
+
+using GameEvent = std::variant<PlayerMoved, ItemPickedUp, DamageTaken>;
+using GameEventBus = events::EventBusFor_t<GameEvent>;
+
+template <typename Event>
+void print_stats(const char* name, const GameEventBus& bus) {
+  events::EventStats stats = bus.stats<Event>();
+  std::cout << "  " << name << ": published=" << stats.published
+            << " dispatched=" << stats.dispatched
+            << " batches=" << stats.batches << std::endl;
+}
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 型ごとのまとめ配送 ===" << std::endl;
+
+  GameEventBus bus;
+  bus.subscribe<PlayerMoved>([](std::span<const PlayerMoved> batch) {
+    std::cout << "PlayerMoved x" << batch.size() << ":";
+    for (const auto& e : batch) {
+      std::cout << " (" << e.x << ", " << e.y << ")";
+    }
+    std::cout << std::endl;
+  });
+  bus.subscribe<ItemPickedUp>([](std::span<const ItemPickedUp> batch) {
+    for (const auto& e : batch) {
+      std::cout << "Picked up " << e.item_name << " (ID: " << e.item_id << ")"
+                << std::endl;
+    }
+  });
+  bus.subscribe<DamageTaken>([](std::span<const DamageTaken> batch) {
+    int total = 0;
+    for (const auto& e : batch) {
+      total += e.amount;
+    }
+    std::cout << "Took " << total << " damage in " << batch.size() << " hits"
+              << std::endl;
+  });
+
+  // フレーム 1: 生産側が書き込む
+  bus.publish(PlayerMoved{10.5f, 20.3f});
+  bus.emplace<ItemPickedUp>(1, "Health Potion");
+  bus.emplace<DamageTaken>(15, "Goblin");
+  bus.publish(PlayerMoved{15.0f, 25.0f});
+  bus.publish(GameEvent{ItemPickedUp{2, "Sword"}});  // variant のままでもよい
+
+  // フレームの境目で入れ替え、前のフレームを配送する
+  bus.swap_buffers();
+  bus.emplace<DamageTaken>(5, "Slime");  // 次のフレーム分（まだ配送されない）
+  std::cout << "配送待ち PlayerMoved: " << bus.pending<PlayerMoved>()
+            << std::endl;
+  bus.dispatch();
+
+  std::cout << "統計:" << std::endl;
+  print_stats<PlayerMoved>("PlayerMoved ", bus);
+  print_stats<ItemPickedUp>("ItemPickedUp", bus);
+  print_stats<DamageTaken>("DamageTaken ", bus);
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. 比較用: solution.cpp と同じ 1件ずつの std::visit
+// ============================================================================
+
+// 購読者の仕事（どちらの方式でも同じ計算をさせる）
+struct FrameTotals {
+  double moved = 0;
+  long long items = 0;
+  long long damage = 0;
+
+  long long checksum() const {
+    return static_cast<long long>(moved) + items + damage;
+  }
+};
+
+void process_visit(const std::vector<GameEvent>& events, FrameTotals& totals) {
+  for (const auto& event : events) {
+    std::visit(overloaded{[&](const PlayerMoved& e) { totals.moved += e.x + e.y; },
+                          [&](const ItemPickedUp& e) {
+                            totals.items +=
+                                e.item_id + static_cast<long long>(e.item_name.size());
+                          },
+                          [&](const DamageTaken& e) { totals.damage += e.amount; }},
+               event);
+  }
+}
+
+void subscribe_totals(GameEventBus& bus, FrameTotals& totals) {
+  bus.subscribe<PlayerMoved>([&](std::span<const PlayerMoved> batch) {
+    double sum = 0;
+    for (const auto& e : batch) {
+      sum += e.x + e.y;
+    }
+    totals.moved += sum;
+  });
+  bus.subscribe<ItemPickedUp>([&](std::span<const ItemPickedUp> batch) {
+    for (const auto& e : batch) {
+      totals.items += e.item_id + static_cast<long long>(e.item_name.size());
+    }
+  });
+  bus.subscribe<DamageTaken>([&](std::span<const DamageTaken> batch) {
+    long long sum = 0;
+    for (const auto& e : batch) {
+      sum += e.amount;
+    }
+    totals.damage += sum;
+  });
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+// フレームごとのイベント列（移動 80%、被ダメージ 15%、取得 5%）
+std::vector<uint8_t> make_frame_pattern(size_t count) {
+  std::mt19937 rng(42);
+  std::vector<uint8_t> kinds(count);
+  for (auto& kind : kinds) {
+    unsigned roll = rng() % 100;
+    kind = roll < 80 ? 0 : roll < 95 ? 2 : 1;
+  }
+  return kinds;
+}
+
+template <typename Publish>
+void produce_frame(const std::vector<uint8_t>& kinds, int frame,
+                   Publish&& publish) {
+  for (size_t i = 0; i < kinds.size(); ++i) {
+    int n = frame + static_cast<int>(i);
+    switch (kinds[i]) {
+      case 0:
+        publish(PlayerMoved{static_cast<float>(n & 1023), 1.0f});
+        break;
+      case 1:
+        publish(ItemPickedUp{n & 255, "Potion"});
+        break;
+      default:
+        publish(DamageTaken{n & 15, "Goblin"});
+        break;
+    }
+  }
+}
+
+void benchmark_example() {
+  constexpr size_t kEventsPerFrame = 1000000;
+  constexpr int kFrames = 30;
+  std::cout << "=== ベンチマーク（1フレーム " << kEventsPerFrame << " 件 × "
+            << kFrames << " フレーム）===" << std::endl;
+  std::cout << "sizeof(GameEvent)=" << sizeof(GameEvent)
+            << " sizeof(PlayerMoved)=" << sizeof(PlayerMoved) << std::endl;
+
+  const std::vector<uint8_t> kinds = make_frame_pattern(kEventsPerFrame);
+  using Millis = std::chrono::duration<double, std::milli>;
+  auto report = [&](const char* label, auto begin, Millis consume,
+                    const FrameTotals& totals) {
+    Millis elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << label << ": " << elapsed.count() / kFrames
+              << " ms/フレーム (うち配送 " << consume.count() / kFrames
+              << " ms, checksum " << totals.checksum() << ")" << std::endl;
+  };
+
+  // vector<GameEvent> に混ぜて入れ、1件ずつ std::visit
+  {
+    FrameTotals totals;
+    std::vector<GameEvent> events;
+    Millis consume{};
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+      events.clear();
+      produce_frame(kinds, frame,
+                    [&](auto&& event) { events.emplace_back(std::move(event)); });
+      auto consume_begin = std::chrono::steady_clock::now();
+      process_visit(events, totals);
+      consume += std::chrono::steady_clock::now() - consume_begin;
+    }
+    report("vector<GameEvent> + visit      ", begin, consume, totals);
+  }
+
+  // 型ごとのキュー（1スレッドで書いて、入れ替えて、配送）
+  {
+    FrameTotals totals;
+    GameEventBus bus;
+    subscribe_totals(bus, totals);
+    Millis consume{};
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+      produce_frame(kinds, frame,
+                    [&](auto&& event) { bus.publish(std::move(event)); });
+      auto consume_begin = std::chrono::steady_clock::now();
+      bus.swap_buffers();
+      bus.dispatch();
+      consume += std::chrono::steady_clock::now() - consume_begin;
+    }
+    report("EventBus（1スレッド）          ", begin, consume, totals);
+  }
+
+  // 生産スレッドがフレーム N を書く間に、消費スレッドがフレーム N-1 を配送する
+  {
+    FrameTotals totals;
+    GameEventBus bus;
+    subscribe_totals(bus, totals);
+    std::barrier frame_end(2, [&bus]() noexcept { bus.swap_buffers(); });
+
+    Millis consume{};
+    auto begin = std::chrono::steady_clock::now();
+    std::thread consumer([&] {
+      for (int frame = 0; frame <= kFrames; ++frame) {
+        auto consume_begin = std::chrono::steady_clock::now();
+        bus.dispatch();
+        consume += std::chrono::steady_clock::now() - consume_begin;
+        frame_end.arrive_and_wait();
+      }
+    });
+    for (int frame = 0; frame <= kFrames; ++frame) {
+      if (frame < kFrames) {
+        produce_frame(kinds, frame,
+                      [&](auto&& event) { bus.publish(std::move(event)); });
+      }
+      frame_end.arrive_and_wait();
+    }
+    consumer.join();
+    report("EventBus（生産/消費 2スレッド）", begin, consume, totals);
+    std::cout << "（" << std::thread::hardware_concurrency() << " コア）"
+              << std::endl;
+
+    print_stats<PlayerMoved>("PlayerMoved ", bus);
+    print_stats<ItemPickedUp>("ItemPickedUp", bus);
+    print_stats<DamageTaken>("DamageTaken ", bus);
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "型ごとにまとめて配送するイベントバスのサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
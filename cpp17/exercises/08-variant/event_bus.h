@@ -0,0 +1,176 @@
+// 型ごとにまとめて配送するイベントバス
+// solution.cpp の exercise_1_8_1 は std::vector<GameEvent>（variant の配列）に
+// 全イベントを混ぜて入れ、1件ずつ std::visit で分岐する。イベント数が多いと
+//   - 1件ごとに variant のタグで間接分岐し
+//   - 大きさの違う型が同じキャッシュラインに混ざり、一番大きい型の幅で並ぶ
+// ので、フレーム時間の無視できない割合を占める。ここでは
+//   - イベント型ごとに連続したキューを持ち（EventBus<PlayerMoved, ...>）
+//   - 購読者には std::span<const T> でまとめて渡し（分岐は型ごとに1回）
+//   - キューを二重化し、生産側が今のフレームを書いている間に
+//     消費側が前のフレームを読めるようにする
+//   - 型ごとに件数・バッチ数を数える
+// とする。
+//
+// スレッドの約束:
+//   - publish / emplace は生産側の1スレッドから呼ぶ
+//   - dispatch は消費側の1スレッドから呼ぶ（publish と同時でよい）
+//   - swap_buffers はフレームの境目で、publish と dispatch のどちらも
+//     動いていないときに呼ぶ
+//   - subscribe は dispatch と同時に呼ばない
+//   - stats はどのスレッドからでも読める
+//
+// std::span を使うため C++20 でビルドする。
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace events {
+
+// 型ごとの通算の件数（どのスレッドからでも読める）
+struct EventStats {
+  uint64_t published = 0;   // publish された件数
+  uint64_t dispatched = 0;  // 購読者に渡した件数
+  uint64_t batches = 0;     // 空でないバッチを配送した回数
+};
+
+template <typename... Events>
+class EventBus {
+ public:
+  // ---- 生産側 ----
+
+  template <typename Event>
+    requires(std::is_same_v<std::decay_t<Event>, Events> || ...)
+  void publish(Event&& event) {
+    auto& queue = queue_for<std::decay_t<Event>>();
+    queue.write_buffer().push_back(std::forward<Event>(event));
+    queue.published.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  template <typename Event, typename... Args>
+  Event& emplace(Args&&... args) {
+    auto& queue = queue_for<Event>();
+    Event& event =
+        queue.write_buffer().emplace_back(std::forward<Args>(args)...);
+    queue.published.fetch_add(1, std::memory_order_relaxed);
+    return event;
+  }
+
+  // 既存の variant を受け取る場合（分岐は投入時に1回だけ）
+  void publish(std::variant<Events...> event) {
+    std::visit(
+        [this](auto& alternative) { publish(std::move(alternative)); }, event);
+  }
+
+  // ---- 購読 ----
+
+  template <typename Event, typename Handler>
+  void subscribe(Handler&& handler) {
+    queue_for<Event>().subscribers.emplace_back(
+        std::forward<Handler>(handler));
+  }
+
+  // ---- フレームの境目 ----
+
+  // 書き込み側と読み取り側を入れ替える。読み残しは捨てる
+  void swap_buffers() {
+    std::apply([](auto&... queue) { (queue.swap(), ...); }, queues_);
+  }
+
+  // 前のフレームのイベントを型ごとにまとめて購読者へ渡し、空にする
+  void dispatch() {
+    std::apply([](auto&... queue) { (queue.dispatch(), ...); }, queues_);
+  }
+
+  // 前のフレームで読み取り側にあるイベント数（型ごと）
+  template <typename Event>
+  size_t pending() const {
+    return queue_for<Event>().read_buffer().size();
+  }
+
+  template <typename Event>
+  EventStats stats() const {
+    const auto& queue = queue_for<Event>();
+    return {queue.published.load(std::memory_order_relaxed),
+            queue.dispatched.load(std::memory_order_relaxed),
+            queue.batches.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  template <typename Event>
+  struct Queue {
+    std::vector<Event>& write_buffer() { return buffers[write_index]; }
+    std::vector<Event>& read_buffer() { return buffers[write_index ^ 1]; }
+    const std::vector<Event>& read_buffer() const {
+      return buffers[write_index ^ 1];
+    }
+
+    void swap() {
+      read_buffer().clear();  // 容量は残す
+      write_index ^= 1;
+    }
+
+    void dispatch() {
+      std::vector<Event>& batch = read_buffer();
+      if (batch.empty()) {
+        return;
+      }
+      std::span<const Event> view(batch);
+      for (const auto& subscriber : subscribers) {
+        subscriber(view);
+      }
+      dispatched.fetch_add(batch.size(), std::memory_order_relaxed);
+      batches.fetch_add(1, std::memory_order_relaxed);
+      batch.clear();
+    }
+
+    std::array<std::vector<Event>, 2> buffers;
+    size_t write_index = 0;
+    std::vector<std::function<void(std::span<const Event>)>> subscribers;
+
+    // 生産側と消費側が別々に更新するので、キャッシュラインを分ける
+    alignas(64) std::atomic<uint64_t> published{0};
+    alignas(64) std::atomic<uint64_t> dispatched{0};
+    std::atomic<uint64_t> batches{0};
+  };
+
+  template <typename Event>
+  Queue<Event>& queue_for() {
+    static_assert((std::is_same_v<Event, Events> || ...),
+                  "EventBus に登録されていないイベント型です");
+    return std::get<Queue<Event>>(queues_);
+  }
+
+  template <typename Event>
+  const Queue<Event>& queue_for() const {
+    static_assert((std::is_same_v<Event, Events> || ...),
+                  "EventBus に登録されていないイベント型です");
+    return std::get<Queue<Event>>(queues_);
+  }
+
+  std::tuple<Queue<Events>...> queues_;
+};
+
+// std::variant<A, B, C> から EventBus<A, B, C> を作る
+template <typename Variant>
+struct EventBusFor;
+
+template <typename... Events>
+struct EventBusFor<std::variant<Events...>> {
+  using type = EventBus<Events...>;
+};
+
+template <typename Variant>
+using EventBusFor_t = typename EventBusFor<Variant>::type;
+
+}  // namespace events
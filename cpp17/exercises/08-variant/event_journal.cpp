@@ -0,0 +1,521 @@
+// event_journal.h のサンプルとベンチマーク
+//   - GameEvent の記録・再生・途中からの再生
+//   - close されなかったジャーナルの読み取り
+//   - std::ofstream / std::ifstream による記録・再生との比較（1千万件）
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "event_journal.h"
+
+// ============================================================================
+// イベント型（solution.cpp と同じ）と書式
+// ============================================================================
+
+template <class... Ts>
+struct overloaded : Ts... {
+  using Ts::operator()...;
+};
+template <class... Ts>
+overloaded(Ts...) -> overloaded<Ts...>;
+
+struct PlayerMoved {
+  float x;
+  float y;
+};
+
+struct ItemPickedUp {
+  int item_id;
+  std::string item_name;
+};
+
+struct DamageTaken {
+  int amount;
+  std::string source;
+};
+
+using GameEvent = std::variant<PlayerMoved, ItemPickedUp, DamageTaken>;
+
+// 再生時はマッピング内の文字列を指すだけにする
+struct ItemPickedUpView {
+  int item_id;
+  std::string_view item_name;
+};
+
+struct DamageTakenView {
+  int amount;
+  std::string_view source;
+};
+
+namespace events {
+
+template <>
+struct EventCodec<PlayerMoved> {
+  using View = PlayerMoved;
+  static size_t encoded_size(const PlayerMoved&) { return 2 * sizeof(float); }
+  static void encode(const PlayerMoved& e, char* out) { put(put(out, e.x), e.y); }
+  static View decode(PayloadReader& in) {
+    return {in.get<float>(), in.get<float>()};
+  }
+};
+
+template <>
+struct EventCodec<ItemPickedUp> {
+  using View = ItemPickedUpView;
+  static size_t encoded_size(const ItemPickedUp& e) {
+    return sizeof(int32_t) + string_size(e.item_name);
+  }
+  static void encode(const ItemPickedUp& e, char* out) {
+    put_string(put(out, static_cast<int32_t>(e.item_id)), e.item_name);
+  }
+  static View decode(PayloadReader& in) {
+    return {in.get<int32_t>(), in.get_string()};
+  }
+};
+
+template <>
+struct EventCodec<DamageTaken> {
+  using View = DamageTakenView;
+  static size_t encoded_size(const DamageTaken& e) {
+    return sizeof(int32_t) + string_size(e.source);
+  }
+  static void encode(const DamageTaken& e, char* out) {
+    put_string(put(out, static_cast<int32_t>(e.amount)), e.source);
+  }
+  static View decode(PayloadReader& in) {
+    return {in.get<int32_t>(), in.get_string()};
+  }
+};
+
+}  // namespace events
+
+using JournalWriter = events::JournalFor<GameEvent>::Writer;
+using JournalReader = events::JournalFor<GameEvent>::Reader;
+
+void print_event(const JournalReader::EventView& event) {
+  std::visit(overloaded{[](const PlayerMoved& e) {
+                          std::cout << "Player moved to (" << e.x << ", "
+                                    << e.y << ")" << std::endl;
+                        },
+                        [](const ItemPickedUpView& e) {
+                          std::cout << "Picked up " << e.item_name
+                                    << " (ID: " << e.item_id << ")" << std::endl;
+                        },
+                        [](const DamageTakenView& e) {
+                          std::cout << "Took " << e.amount << " damage from "
+                                    << e.source << std::endl;
+                        }},
+             event);
+}
+
+// 記録したイベントと再生したイベントが同じか
+bool same_event(const GameEvent& expected,
+                const JournalReader::EventView& actual) {
+  if (expected.index() != actual.index()) {
+    return false;
+  }
+  return std::visit(
+      overloaded{[&](const PlayerMoved& e) {
+                   const auto& a = std::get<PlayerMoved>(actual);
+                   return e.x == a.x && e.y == a.y;
+                 },
+                 [&](const ItemPickedUp& e) {
+                   const auto& a = std::get<ItemPickedUpView>(actual);
+                   return e.item_id == a.item_id && e.item_name == a.item_name;
+                 },
+                 [&](const DamageTaken& e) {
+                   const auto& a = std::get<DamageTakenView>(actual);
+                   return e.amount == a.amount && e.source == a.source;
+                 }},
+      expected);
+}
+
+std::string temp_path(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 記録と再生 ===" << std::endl;
+
+  std::string path = temp_path("event_journal_basic.bin");
+  events::JournalOptions options;
+  options.index_stride = 2;  // 2件ごとに索引を残す
+  {
+    JournalWriter journal(options);
+    if (!journal.open(path)) {
+      std::cout << journal.error() << std::endl;
+      return;
+    }
+    journal.append(PlayerMoved{10.5f, 20.3f});
+    journal.append(ItemPickedUp{1, "Health Potion"});
+    journal.append(DamageTaken{15, "Goblin"});
+    journal.append(GameEvent{PlayerMoved{15.0f, 25.0f}});  // variant のままでもよい
+    journal.append(ItemPickedUp{2, "Sword"});
+    journal.flush_if_due();  // フレームの終わりに呼ぶ
+    std::cout << journal.event_count() << " 件 / " << journal.bytes()
+              << " バイト記録" << std::endl;
+  }  // デストラクタで索引を書いて閉じる
+
+  JournalReader reader;
+  if (!reader.open(path)) {
+    std::cout << reader.error() << std::endl;
+    return;
+  }
+  std::cout << "先頭から:" << std::endl;
+  auto cursor = reader.begin();
+  while (auto event = cursor.next()) {
+    std::cout << "  [" << cursor.position() - 1 << "] ";
+    print_event(*event);
+  }
+  std::cout << "3 件目から:" << std::endl;
+  cursor = reader.seek(3);
+  while (auto event = cursor.next()) {
+    std::cout << "  [" << cursor.position() - 1 << "] ";
+    print_event(*event);
+  }
+  std::filesystem::remove(path);
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. close されていないジャーナル（書き込み中・異常終了）を読む
+// ============================================================================
+
+std::vector<GameEvent> make_events(size_t count, unsigned seed) {
+  static const char* const kItems[] = {"Sword", "Health Potion", "Shield",
+                                       "Ancient Scroll of Forgotten Kings"};
+  static const char* const kSources[] = {"Goblin", "Slime", "Trap",
+                                         "Dragon breath from the northern peak"};
+  std::mt19937 rng(seed);
+  std::vector<GameEvent> events;
+  events.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    unsigned roll = rng() % 100;
+    if (roll < 80) {
+      events.emplace_back(PlayerMoved{static_cast<float>(rng() % 10000) / 8,
+                                      static_cast<float>(rng() % 10000) / 8});
+    } else if (roll < 95) {
+      events.emplace_back(DamageTaken{static_cast<int>(rng() % 100),
+                                      kSources[rng() % 4]});
+    } else {
+      events.emplace_back(
+          ItemPickedUp{static_cast<int>(rng() % 1000), kItems[rng() % 4]});
+    }
+  }
+  return events;
+}
+
+void recovery_example() {
+  std::cout << "=== 書き込み中のジャーナルを読む ===" << std::endl;
+
+  std::string path = temp_path("event_journal_live.bin");
+  std::vector<GameEvent> events = make_events(100000, 1);
+  events::JournalOptions options;
+  options.initial_capacity = size_t{1} << 20;  // 途中で拡張させる
+  JournalWriter journal(options);
+  if (!journal.open(path)) {
+    std::cout << journal.error() << std::endl;
+    return;
+  }
+  for (const auto& event : events) {
+    journal.append(event);
+  }
+  journal.sync();
+
+  // まだ close していないので、フッタはなく末尾は 0 で埋まっている
+  JournalReader reader;
+  reader.open(path);
+  size_t mismatches = reader.size() != events.size();
+  auto cursor = reader.begin();
+  for (const auto& expected : events) {
+    auto actual = cursor.next();
+    mismatches += !actual || !same_event(expected, *actual);
+  }
+  std::cout << "索引を走査で作り直した: " << (reader.recovered() ? "はい" : "いいえ")
+            << " / " << reader.size() << " 件 / 不一致 " << mismatches
+            << std::endl;
+
+  journal.close();
+
+  // close 済み（フッタあり）のファイルで 2 件目の長さを壊す。
+  // 範囲外の長さも、ペイロードが足りない長さも、そこで nullopt になる
+  for (uint32_t bogus : {0xFFFFFFF0u, 1u}) {
+    {
+      std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+      uint32_t first = 0;
+      file.seekg(events::detail::kHeaderSize);
+      file.read(reinterpret_cast<char*>(&first), sizeof(first));
+      file.seekp(events::detail::kHeaderSize + sizeof(first) + first);
+      file.write(reinterpret_cast<const char*>(&bogus), sizeof(bogus));
+    }
+    JournalReader damaged;
+    damaged.open(path);
+    auto damaged_cursor = damaged.begin();
+    size_t readable = 0;
+    while (damaged_cursor.next()) {
+      ++readable;
+    }
+    auto tail = damaged.seek(10);
+    std::cout << "2 件目の長さを " << bogus << " にした: フッタ上 "
+              << damaged.size() << " 件 / 読めた " << readable
+              << " 件 / seek(10) の next: "
+              << (tail.next() ? "読めた" : "nullopt") << std::endl;
+  }
+
+  // フッタの件数を桁あふれする値にし、data_end を索引の先に向ける。
+  // フッタは使わず、走査で読み直す
+  {
+    uint64_t file_size = std::filesystem::file_size(path);
+    uint64_t data_end = file_size - 16;
+    uint64_t count = (uint64_t{1} << 61) - 1;  // count * 8 が 2^64 - 8 になる
+    uint32_t stride = 1;
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(file_size - events::detail::kFooterSize));
+    file.write(reinterpret_cast<const char*>(&data_end), sizeof(data_end));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(&stride), sizeof(stride));
+  }
+  JournalReader crafted;
+  crafted.open(path);
+  std::cout << "フッタを書き換えた: 走査で読み直した="
+            << (crafted.recovered() ? "はい" : "いいえ") << " / "
+            << crafted.size() << " 件" << std::endl;
+
+  std::filesystem::remove(path);
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 3. 比較用: std::ofstream / std::ifstream で同じ形式を読み書きする
+// ============================================================================
+
+class StreamJournal {
+ public:
+  explicit StreamJournal(const std::string& path)
+      : output_(path, std::ios::binary) {
+    char header[events::detail::kHeaderSize] = {'G', 'E', 'V', 'J'};
+    events::put(events::put(header + 4, events::detail::kJournalVersion),
+                uint32_t{3});
+    output_.write(header, sizeof(header));
+  }
+
+  void append(const GameEvent& event) {
+    std::visit(
+        [&](const auto& e) {
+          using Codec = events::EventCodec<std::decay_t<decltype(e)>>;
+          size_t payload = Codec::encoded_size(e);
+          buffer_.resize(events::detail::kRecordHeaderSize + payload);
+          char* out = events::put(buffer_.data(),
+                                  static_cast<uint32_t>(1 + payload));
+          out = events::put(out, static_cast<uint8_t>(event.index()));
+          Codec::encode(e, out);
+          output_.write(buffer_.data(),
+                        static_cast<std::streamsize>(buffer_.size()));
+        },
+        event);
+  }
+
+  void flush() { output_.flush(); }
+
+ private:
+  std::ofstream output_;
+  std::vector<char> buffer_;
+};
+
+// 1件ずつ読み、文字列は std::string にコピーして GameEvent に戻す
+template <typename Func>
+void stream_replay(const std::string& path, Func&& func) {
+  std::ifstream input(path, std::ios::binary);
+  input.seekg(events::detail::kHeaderSize);
+  std::vector<char> buffer;
+  uint32_t length = 0;
+  while (input.read(reinterpret_cast<char*>(&length), sizeof(length)) &&
+         length != 0) {
+    buffer.resize(length);
+    if (!input.read(buffer.data(), length)) {
+      break;
+    }
+    events::PayloadReader in(std::string_view(buffer.data() + 1, length - 1));
+    switch (buffer[0]) {
+      case 0:
+        func(GameEvent{PlayerMoved{in.get<float>(), in.get<float>()}});
+        break;
+      case 1:
+        func(GameEvent{ItemPickedUp{in.get<int32_t>(),
+                                    std::string(in.get_string())}});
+        break;
+      default:
+        func(GameEvent{DamageTaken{in.get<int32_t>(),
+                                   std::string(in.get_string())}});
+        break;
+    }
+  }
+}
+
+// ============================================================================
+// 4. ベンチマーク
+// ============================================================================
+
+// 1千万件を1万件ずつのフレームに分けて記録し、フレームあたりの平均と最悪を測る
+template <typename Append, typename EndFrame>
+void measure_frames(const char* label, const std::vector<GameEvent>& events,
+                    Append&& append, EndFrame&& end_frame) {
+  constexpr size_t kEventsPerFrame = 10000;
+  using Micros = std::chrono::duration<double, std::micro>;
+  Micros total{};
+  Micros worst{};
+  for (size_t begin = 0; begin < events.size(); begin += kEventsPerFrame) {
+    size_t end = std::min(events.size(), begin + kEventsPerFrame);
+    auto frame_begin = std::chrono::steady_clock::now();
+    for (size_t i = begin; i < end; ++i) {
+      append(events[i]);
+    }
+    end_frame();
+    Micros frame = std::chrono::steady_clock::now() - frame_begin;
+    total += frame;
+    worst = std::max(worst, frame);
+  }
+  size_t frames = (events.size() + kEventsPerFrame - 1) / kEventsPerFrame;
+  std::cout << label << ": " << total.count() * 1000 / events.size()
+            << " ns/件, フレーム平均 " << total.count() / frames
+            << " us / 最悪 " << worst.count() << " us" << std::endl;
+}
+
+template <typename Func>
+void measure_replay(const char* label, size_t count, Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  long long checksum = func();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << label << ": " << elapsed.count() / count
+            << " ns/件 (checksum " << checksum << ")" << std::endl;
+}
+
+long long event_weight(const JournalReader::EventView& event) {
+  return std::visit(
+      overloaded{[](const PlayerMoved& e) { return static_cast<long long>(e.x); },
+                 [](const ItemPickedUpView& e) {
+                   return static_cast<long long>(e.item_id + e.item_name.size());
+                 },
+                 [](const DamageTakenView& e) {
+                   return static_cast<long long>(e.amount + e.source.size());
+                 }},
+      event);
+}
+
+long long event_weight(const GameEvent& event) {
+  return std::visit(
+      overloaded{[](const PlayerMoved& e) { return static_cast<long long>(e.x); },
+                 [](const ItemPickedUp& e) {
+                   return static_cast<long long>(e.item_id + e.item_name.size());
+                 },
+                 [](const DamageTaken& e) {
+                   return static_cast<long long>(e.amount + e.source.size());
+                 }},
+      event);
+}
+
+void benchmark_example() {
+  constexpr size_t kEvents = 10000000;
+  std::cout << "=== ベンチマーク（" << kEvents << " 件）===" << std::endl;
+
+  std::vector<GameEvent> events = make_events(kEvents, 42);
+  std::string stream_path = temp_path("event_journal_stream.bin");
+  std::string mapped_path = temp_path("event_journal_mapped.bin");
+
+  {
+    StreamJournal journal(stream_path);
+    measure_frames(
+        "記録 std::ofstream              ", events,
+        [&](const GameEvent& event) { journal.append(event); },
+        [&] { journal.flush(); });
+  }
+
+  // 既定の 64 MB から始め、フレームの区切り（flush_if_due）で 2 回張り直す
+  JournalWriter writer;
+  if (!writer.open(mapped_path)) {
+    std::cout << writer.error() << std::endl;
+    return;
+  }
+  measure_frames(
+      "記録 JournalWriter（mmap）      ", events,
+      [&](const GameEvent& event) { writer.append(event); },
+      [&] { writer.flush_if_due(); });
+  std::cout << "ファイルの大きさ: " << writer.bytes() / (1 << 20) << " MB"
+            << std::endl;
+  writer.close();
+
+  JournalReader reader;
+  if (!reader.open(mapped_path)) {
+    std::cout << reader.error() << std::endl;
+    return;
+  }
+
+  measure_replay("再生 std::ifstream（コピー）    ", kEvents, [&] {
+    long long checksum = 0;
+    stream_replay(stream_path,
+                  [&](const GameEvent& event) { checksum += event_weight(event); });
+    return checksum;
+  });
+  measure_replay("再生 JournalReader（コピーなし）", kEvents, [&] {
+    long long checksum = 0;
+    auto cursor = reader.begin();
+    while (auto event = cursor.next()) {
+      checksum += event_weight(*event);
+    }
+    return checksum;
+  });
+
+  // 順序と内容が完全に一致するか
+  size_t mismatches = reader.size() != events.size();
+  auto cursor = reader.begin();
+  for (const auto& expected : events) {
+    auto actual = cursor.next();
+    mismatches += !actual || !same_event(expected, *actual);
+  }
+  std::mt19937 rng(7);
+  for (int i = 0; i < 10000; ++i) {
+    uint64_t position = rng() % kEvents;
+    auto actual = reader.seek(position).next();
+    mismatches += !actual || !same_event(events[position], *actual);
+  }
+  std::cout << "再生の不一致: " << mismatches << std::endl;
+
+  measure_replay("seek（索引 4096 件ごと）+ 1件   ", 100000, [&] {
+    long long checksum = 0;
+    for (int i = 0; i < 100000; ++i) {
+      checksum += event_weight(*reader.seek(rng() % kEvents).next());
+    }
+    return checksum;
+  });
+
+  std::filesystem::remove(stream_path);
+  std::filesystem::remove(mapped_path);
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "GameEvent の追記専用ジャーナルのサンプル\n" << std::endl;
+
+  basic_example();
+  recovery_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
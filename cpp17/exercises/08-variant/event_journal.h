@@ -0,0 +1,795 @@
+// GameEvent の列をそのまま記録・再生する追記専用ジャーナル
+// 本番でも全イベントを記録しておきたいが、フレームの途中で write(2) や
+// iostream を呼ぶとシステムコールとコピーでフレーム時間が揺れる。ここでは
+//   - ファイルを mmap（Windows は MapViewOfFile）し、イベントはマッピングへ
+//     直接書き込む（容量が尽きたときだけ拡張して張り直す）
+//   - 書き出しは一定バイト数ごと・一定時間ごとに OS へ依頼するだけで待たない
+//   - 再生側もファイルを mmap し、文字列は std::string_view で指すだけにする
+//   - N 件ごとの位置を索引としてファイル末尾に残し、途中から再生できる
+// とする。
+//
+// ファイルの形式（数値はすべてホストのバイト順。同じ機械で読む前提）:
+//   ヘッダ     "GEVJ" u32 バージョン u32 型の数
+//   レコード   u32 長さ（型番号 + 本体）u8 型番号（variant の index）本体
+//   ...
+//   索引       u64 オフセット × ceil(件数 / 間隔)
+//   フッタ     u64 レコード部の終端 u64 件数 u32 間隔 "GEVI"
+// close しないまま落ちた場合はフッタがなく、末尾は 0 で埋まっている。
+// 再生側は長さ 0 か途中で切れたレコードを終端とみなし、索引は走査して作り直す。
+//
+// イベント型ごとの書式は EventCodec<T> を特殊化して与える:
+//   using View = ...;                                   // 再生時に渡す型
+//   static size_t encoded_size(const T&);
+//   static void encode(const T&, char* out);            // encoded_size バイト書く
+//   static View decode(PayloadReader& in);
+//
+// 記録は publish した順に1本の列へ入れる。EventBus は型ごとに並べ替えるので、
+// 順序を残したいならバスに入れる前（生産側）で append する。
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace events {
+
+template <typename Event>
+struct EventCodec;
+
+// ============================================================================
+// 本体の読み書き（EventCodec から使う）
+// ============================================================================
+
+template <typename T>
+char* put(char* out, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  std::memcpy(out, &value, sizeof(T));
+  return out + sizeof(T);
+}
+
+inline char* put_string(char* out, std::string_view text) {
+  out = put(out, static_cast<uint32_t>(text.size()));
+  std::memcpy(out, text.data(), text.size());
+  return out + text.size();
+}
+
+inline size_t string_size(std::string_view text) {
+  return sizeof(uint32_t) + text.size();
+}
+
+// レコード本体を先頭から読む。足りなければ ok() が false になり、以降は 0 / 空を返す
+class PayloadReader {
+ public:
+  explicit PayloadReader(std::string_view payload) : rest_(payload) {}
+
+  template <typename T>
+  T get() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (rest_.size() < sizeof(T)) {
+      ok_ = false;
+      rest_ = {};
+      return value;
+    }
+    std::memcpy(&value, rest_.data(), sizeof(T));
+    rest_.remove_prefix(sizeof(T));
+    return value;
+  }
+
+  std::string_view get_string() {
+    uint32_t length = get<uint32_t>();
+    if (rest_.size() < length) {
+      ok_ = false;
+      rest_ = {};
+      return {};
+    }
+    std::string_view text = rest_.substr(0, length);
+    rest_.remove_prefix(length);
+    return text;
+  }
+
+  bool ok() const { return ok_; }
+
+ private:
+  std::string_view rest_;
+  bool ok_ = true;
+};
+
+// ============================================================================
+// 書き込み・同期の方針
+// ============================================================================
+
+struct JournalOptions {
+  // 最初にマップする大きさ。残りが 1/4 を切ると flush_if_due（フレームの区切り）で
+  // 倍に張り直すので、append の途中では張り直さない（128 → 256 MB で 1 ms 弱）。
+  // 中身のない部分はディスクを使わないので、1セッション分を見込んでおくとよい
+  size_t initial_capacity = size_t{64} << 20;
+  uint32_t index_stride = 4096;                // 何件ごとに索引を残すか
+  // これだけ書いたら書き出しを依頼する。依頼した append が I/O の投入を待つので、
+  // 大きいとそのフレームが止まる（8 MB で 5〜8 ms、1 MB で 2 ms 弱）
+  size_t sync_bytes = size_t{1} << 20;
+  std::chrono::milliseconds sync_interval{1000};  // flush_if_due の間隔
+};
+
+namespace detail {
+
+inline constexpr char kJournalMagic[4] = {'G', 'E', 'V', 'J'};
+inline constexpr char kIndexMagic[4] = {'G', 'E', 'V', 'I'};
+inline constexpr uint32_t kJournalVersion = 1;
+inline constexpr size_t kHeaderSize = 12;
+inline constexpr size_t kRecordHeaderSize = sizeof(uint32_t) + sizeof(uint8_t);
+inline constexpr size_t kFooterSize = 24;
+
+template <typename Event, typename... Events>
+constexpr size_t index_of() {
+  constexpr bool matches[] = {std::is_same_v<Event, Events>...};
+  for (size_t i = 0; i < sizeof...(Events); ++i) {
+    if (matches[i]) {
+      return i;
+    }
+  }
+  return sizeof...(Events);
+}
+
+// ----------------------------------------------------------------------------
+// 読み書きできるファイルマッピング（大きさを変えるときは張り直す）
+// ----------------------------------------------------------------------------
+
+class WritableMapping {
+ public:
+  WritableMapping() = default;
+  ~WritableMapping() { close(size_); }
+
+  WritableMapping(const WritableMapping&) = delete;
+  WritableMapping& operator=(const WritableMapping&) = delete;
+
+  bool open(const std::string& path, size_t size) {
+#if defined(_WIN32)
+    file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                        FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      file_ = nullptr;
+      return false;
+    }
+#else
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      return false;
+    }
+#endif
+    if (!map(size)) {
+      close(0);
+      return false;
+    }
+    return true;
+  }
+
+  // 中身を保ったまま大きさを変える
+  bool resize(size_t size) {
+    unmap();
+    return map(size);
+  }
+
+  // [offset, offset + length) の書き出しを依頼する。wait なら完了まで待つ
+  void flush(size_t offset, size_t length, bool wait) {
+    if (data_ == nullptr || length == 0) {
+      return;
+    }
+#if defined(_WIN32)
+    FlushViewOfFile(data_ + offset, length);
+    if (wait) {
+      FlushFileBuffers(file_);
+    }
+#else
+    if (wait) {
+      size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      size_t begin = offset / page * page;
+      msync(data_ + begin, offset + length - begin, MS_SYNC);
+      return;
+    }
+#if defined(__linux__)
+    // MS_ASYNC は Linux では何もしないので、書き出しの開始だけを依頼する
+    sync_file_range(fd_, static_cast<off_t>(offset),
+                    static_cast<off_t>(length), SYNC_FILE_RANGE_WRITE);
+#else
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = offset / page * page;
+    msync(data_ + begin, offset + length - begin, MS_ASYNC);
+#endif
+#endif
+  }
+
+  // マッピングを外し、ファイルを final_size に切り詰めて閉じる
+  bool close(size_t final_size) {
+    unmap();
+    bool ok = true;
+#if defined(_WIN32)
+    if (file_ != nullptr) {
+      LARGE_INTEGER position;
+      position.QuadPart = static_cast<LONGLONG>(final_size);
+      ok = SetFilePointerEx(file_, position, nullptr, FILE_BEGIN) &&
+           SetEndOfFile(file_);
+      CloseHandle(file_);
+      file_ = nullptr;
+    }
+#else
+    if (fd_ >= 0) {
+      ok = ftruncate(fd_, static_cast<off_t>(final_size)) == 0;
+      ::close(fd_);
+      fd_ = -1;
+    }
+#endif
+    size_ = 0;
+    return ok;
+  }
+
+  char* data() { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  bool map(size_t size) {
+#if defined(_WIN32)
+    // CreateFileMapping はファイルを size まで伸ばす
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE,
+                                  static_cast<DWORD>(uint64_t{size} >> 32),
+                                  static_cast<DWORD>(size), nullptr);
+    if (mapping_ == nullptr) {
+      return false;
+    }
+    data_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, 0));
+#else
+    if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+      return false;
+    }
+    void* address =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    data_ = address == MAP_FAILED ? nullptr : static_cast<char*>(address);
+#endif
+    if (data_ == nullptr) {
+      return false;
+    }
+    size_ = size;
+    return true;
+  }
+
+  void unmap() {
+#if defined(_WIN32)
+    if (data_ != nullptr) {
+      UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+      CloseHandle(mapping_);
+      mapping_ = nullptr;
+    }
+#else
+    if (data_ != nullptr) {
+      munmap(data_, size_);
+    }
+#endif
+    data_ = nullptr;
+  }
+
+  char* data_ = nullptr;
+  size_t size_ = 0;
+#if defined(_WIN32)
+  HANDLE file_ = nullptr;
+  HANDLE mapping_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+// ----------------------------------------------------------------------------
+// 読み取り専用のファイルマッピング
+// ----------------------------------------------------------------------------
+
+class ReadOnlyMapping {
+ public:
+  ReadOnlyMapping() = default;
+  ~ReadOnlyMapping() { close(); }
+
+  ReadOnlyMapping(const ReadOnlyMapping&) = delete;
+  ReadOnlyMapping& operator=(const ReadOnlyMapping&) = delete;
+
+  bool open(const std::string& path) {
+    close();
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+      CloseHandle(file);
+      return false;
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) {
+      CloseHandle(file);
+      return true;
+    }
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+      size_ = 0;
+      return false;
+    }
+    data_ = static_cast<const char*>(
+        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      ::close(fd);
+      return false;
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+      ::close(fd);
+      return true;
+    }
+    void* address = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      size_ = 0;
+      return false;
+    }
+    madvise(address, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(address);
+#endif
+    if (data_ == nullptr) {
+      size_ = 0;
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+    if (data_ != nullptr) {
+#if defined(_WIN32)
+      UnmapViewOfFile(data_);
+#else
+      munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  std::string_view view() const { return {data_, size_}; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace detail
+
+// ============================================================================
+// 書き込み側
+// ============================================================================
+
+template <typename... Events>
+class JournalWriter {
+  static_assert(sizeof...(Events) <= 255, "型番号は u8 に収める");
+
+ public:
+  explicit JournalWriter(JournalOptions options = {}) : options_(options) {
+    if (options_.index_stride == 0) {
+      options_.index_stride = 1;
+    }
+  }
+  ~JournalWriter() { close(); }
+
+  JournalWriter(const JournalWriter&) = delete;
+  JournalWriter& operator=(const JournalWriter&) = delete;
+
+  // path を作り直して書き始める
+  bool open(const std::string& path) {
+    close();
+    error_.clear();
+    size_t capacity = std::max(options_.initial_capacity, size_t{4096});
+    if (!file_.open(path, capacity)) {
+      return fail("ジャーナルを作成できません: " + path);
+    }
+    char* out = file_.data();
+    std::memcpy(out, detail::kJournalMagic, 4);
+    out = put(out + 4, detail::kJournalVersion);
+    put(out, static_cast<uint32_t>(sizeof...(Events)));
+    offset_ = detail::kHeaderSize;
+    synced_ = 0;
+    count_ = 0;
+    index_.clear();
+    last_sync_ = std::chrono::steady_clock::now();
+    open_ = true;
+    return true;
+  }
+
+  // 1件追記する。容量の拡張に失敗したときだけ false
+  template <typename Event>
+  bool append(const Event& event) {
+    constexpr size_t kType = detail::index_of<Event, Events...>();
+    static_assert(kType < sizeof...(Events),
+                  "ジャーナルに登録されていないイベント型です");
+    if (!open_) {
+      return false;
+    }
+    size_t payload = EventCodec<Event>::encoded_size(event);
+    size_t record = detail::kRecordHeaderSize + payload;
+    if (offset_ + record > file_.size() && !grow(offset_ + record)) {
+      return false;
+    }
+    if (count_ % options_.index_stride == 0) {
+      index_.push_back(offset_);
+    }
+    char* out = file_.data() + offset_;
+    out = put(out, static_cast<uint32_t>(1 + payload));
+    out = put(out, static_cast<uint8_t>(kType));
+    EventCodec<Event>::encode(event, out);
+    offset_ += record;
+    ++count_;
+    if (offset_ - synced_ >= options_.sync_bytes) {
+      flush(false);
+    }
+    return true;
+  }
+
+  bool append(const std::variant<Events...>& event) {
+    return std::visit([this](const auto& e) { return append(e); }, event);
+  }
+
+  // 前回から sync_interval 経っていれば書き出しを依頼する（1フレームに1回呼ぶ）。
+  // 残りが 1/4 を切っていれば、ここで先に拡張しておく
+  void flush_if_due() {
+    if (open_ && file_.size() - offset_ < file_.size() / 4) {
+      grow(file_.size() + 1);
+    }
+    if (open_ && offset_ != synced_ &&
+        std::chrono::steady_clock::now() - last_sync_ >=
+            options_.sync_interval) {
+      flush(false);
+    }
+  }
+
+  // ここまでをディスクに書き終えるまで待つ
+  void sync() {
+    if (open_) {
+      flush(true);
+    }
+  }
+
+  // 索引とフッタを書き、ファイルを実際の大きさに切り詰めて閉じる
+  bool close() {
+    if (!open_) {
+      return true;
+    }
+    open_ = false;
+    size_t data_end = offset_;
+    size_t total =
+        data_end + index_.size() * sizeof(uint64_t) + detail::kFooterSize;
+    if (total > file_.size() && !file_.resize(total)) {
+      file_.close(data_end);  // 索引なしでも読めるようにレコードだけ残す
+      return fail("索引を書き込めません");
+    }
+    char* out = file_.data() + data_end;
+    for (uint64_t position : index_) {
+      out = put(out, position);
+    }
+    out = put(out, static_cast<uint64_t>(data_end));
+    out = put(out, count_);
+    out = put(out, options_.index_stride);
+    std::memcpy(out, detail::kIndexMagic, 4);
+    return file_.close(total) || fail("ジャーナルを閉じられません");
+  }
+
+  uint64_t event_count() const { return count_; }
+  size_t bytes() const { return offset_; }
+  const std::string& error() const { return error_; }
+
+ private:
+  bool grow(size_t required) {
+    size_t capacity = file_.size();
+    while (capacity < required) {
+      capacity += std::min(capacity, size_t{1} << 30);
+    }
+    if (!file_.resize(capacity)) {
+      open_ = false;
+      file_.close(offset_);
+      return fail("ジャーナルを拡張できません");
+    }
+    return true;
+  }
+
+  void flush(bool wait) {
+    file_.flush(synced_, offset_ - synced_, wait);
+    synced_ = offset_;
+    last_sync_ = std::chrono::steady_clock::now();
+  }
+
+  bool fail(std::string message) {
+    error_ = std::move(message);
+    return false;
+  }
+
+  JournalOptions options_;
+  detail::WritableMapping file_;
+  bool open_ = false;
+  size_t offset_ = 0;
+  size_t synced_ = 0;
+  uint64_t count_ = 0;
+  std::vector<uint64_t> index_;  // index_stride 件ごとのレコード位置
+  std::chrono::steady_clock::time_point last_sync_;
+  std::string error_;
+};
+
+// ============================================================================
+// 再生側
+// ============================================================================
+
+template <typename... Events>
+class JournalReader {
+ public:
+  // 文字列などはマッピングを指す（リーダーが生きている間だけ有効）
+  using EventView = std::variant<typename EventCodec<Events>::View...>;
+
+  class Cursor {
+   public:
+    // 次のイベント。終端か壊れたレコードなら nullopt
+    std::optional<EventView> next() {
+      if (position_ >= reader_->count_) {
+        return std::nullopt;
+      }
+      // フッタのあるファイルも中身は検証していないので、長さと中身を確かめる
+      auto length = record_length(reader_->data_, offset_);
+      if (!length) {
+        return std::nullopt;
+      }
+      const char* record = reader_->data_.data() + offset_;
+      uint8_t type = static_cast<uint8_t>(record[sizeof(uint32_t)]);
+      if (type >= sizeof...(Events)) {
+        return std::nullopt;
+      }
+      PayloadReader in(std::string_view(record + detail::kRecordHeaderSize,
+                                        *length - 1));
+      EventView event = kDecoders[type](in);
+      if (!in.ok()) {
+        return std::nullopt;
+      }
+      offset_ += sizeof(uint32_t) + *length;
+      ++position_;
+      return event;
+    }
+
+    // 次に next で返すイベントの番号（0 始まり）
+    uint64_t position() const { return position_; }
+
+   private:
+    friend class JournalReader;
+    Cursor(const JournalReader* reader, size_t offset, uint64_t position)
+        : reader_(reader), offset_(offset), position_(position) {}
+
+    const JournalReader* reader_;
+    size_t offset_;
+    uint64_t position_;
+  };
+
+  bool open(const std::string& path) {
+    data_ = {};
+    count_ = 0;
+    index_.clear();
+    error_.clear();
+    recovered_ = false;
+    if (!file_.open(path)) {
+      return fail("ジャーナルを開けません: " + path);
+    }
+    std::string_view view = file_.view();
+    uint32_t version = 0;
+    uint32_t types = 0;
+    if (view.size() >= detail::kHeaderSize) {
+      std::memcpy(&version, view.data() + 4, sizeof(version));
+      std::memcpy(&types, view.data() + 8, sizeof(types));
+    }
+    if (view.size() < detail::kHeaderSize ||
+        std::memcmp(view.data(), detail::kJournalMagic, 4) != 0 ||
+        version != detail::kJournalVersion || types != sizeof...(Events)) {
+      file_.close();
+      return fail("ジャーナルの形式が違います: " + path);
+    }
+    if (!load_footer(view)) {
+      recovered_ = true;
+      scan(view);
+    }
+    return true;
+  }
+
+  // 先頭から再生する
+  Cursor begin() const { return {this, detail::kHeaderSize, 0}; }
+
+  // position 番目のイベントから再生する（索引から近い位置に飛び、残りは読み飛ばす）
+  Cursor seek(uint64_t position) const {
+    if (position >= count_) {
+      return {this, data_.size(), count_};
+    }
+    uint64_t slot = position / stride_;
+    Cursor cursor(this, static_cast<size_t>(index_[slot]), slot * stride_);
+    while (cursor.position_ < position) {
+      // 壊れたレコードで止める（そこからの next は nullopt を返す）
+      auto length = record_length(data_, cursor.offset_);
+      if (!length) {
+        break;
+      }
+      cursor.offset_ += sizeof(uint32_t) + *length;
+      ++cursor.position_;
+    }
+    return cursor;
+  }
+
+  uint64_t size() const { return count_; }
+  // フッタがなく（close されずに終わった）、走査で索引を作り直したか
+  bool recovered() const { return recovered_; }
+  const std::string& error() const { return error_; }
+
+ private:
+  using Decoder = EventView (*)(PayloadReader&);
+
+  template <size_t I, typename Event>
+  static EventView decode_as(PayloadReader& in) {
+    return EventView(std::in_place_index<I>, EventCodec<Event>::decode(in));
+  }
+
+  template <size_t... Is>
+  static constexpr std::array<Decoder, sizeof...(Events)> make_decoders(
+      std::index_sequence<Is...>) {
+    return {&decode_as<Is, Events>...};
+  }
+
+  static constexpr std::array<Decoder, sizeof...(Events)> kDecoders =
+      make_decoders(std::index_sequence_for<Events...>{});
+
+  // offset から始まるレコードの長さ（型番号 + ペイロード）。
+  // ヘッダが収まらない・長さ 0・view の外にはみ出すなら nullopt
+  static std::optional<uint32_t> record_length(std::string_view view,
+                                               size_t offset) {
+    if (offset > view.size() ||
+        view.size() - offset < detail::kRecordHeaderSize) {
+      return std::nullopt;
+    }
+    uint32_t length = 0;
+    std::memcpy(&length, view.data() + offset, sizeof(length));
+    if (length == 0 || view.size() - offset - sizeof(length) < length) {
+      return std::nullopt;
+    }
+    return length;
+  }
+
+  // close 済みのファイルなら末尾の索引をそのまま使う
+  bool load_footer(std::string_view view) {
+    if (view.size() < detail::kHeaderSize + detail::kFooterSize) {
+      return false;
+    }
+    const char* footer = view.data() + view.size() - detail::kFooterSize;
+    if (std::memcmp(footer + 20, detail::kIndexMagic, 4) != 0) {
+      return false;
+    }
+    uint64_t data_end = 0;
+    uint64_t count = 0;
+    uint32_t stride = 0;
+    std::memcpy(&data_end, footer, sizeof(data_end));
+    std::memcpy(&count, footer + 8, sizeof(count));
+    std::memcpy(&stride, footer + 16, sizeof(stride));
+    // フッタの値も信用しない。足し算・掛け算で桁あふれしないよう、
+    // 残りの大きさとの比較だけで範囲を確かめる（だめなら scan で読み直す）
+    uint64_t body_end = view.size() - detail::kFooterSize;
+    if (stride == 0 || data_end < detail::kHeaderSize || data_end > body_end) {
+      return false;
+    }
+    // 1レコードは最低 kRecordHeaderSize バイト
+    if (count > (data_end - detail::kHeaderSize) / detail::kRecordHeaderSize) {
+      return false;
+    }
+    uint64_t slots = count / stride + (count % stride != 0);
+    if (slots != (body_end - data_end) / sizeof(uint64_t) ||
+        (body_end - data_end) % sizeof(uint64_t) != 0) {
+      return false;
+    }
+    std::vector<uint64_t> index(static_cast<size_t>(slots));
+    if (slots != 0) {
+      std::memcpy(index.data(), view.data() + data_end,
+                  index.size() * sizeof(uint64_t));
+    }
+    // 索引は先頭のレコードから始まり、レコード部の中で単調に増えること
+    for (size_t i = 0; i < index.size(); ++i) {
+      bool in_range = index[i] >= detail::kHeaderSize && index[i] < data_end;
+      bool increasing = i == 0 ? index[i] == detail::kHeaderSize
+                               : index[i] > index[i - 1];
+      if (!in_range || !increasing) {
+        return false;
+      }
+    }
+    index_ = std::move(index);
+    data_ = view.substr(0, static_cast<size_t>(data_end));
+    count_ = count;
+    stride_ = stride;
+    return true;
+  }
+
+  // 長さをたどって終端を探し、索引を作る。
+  // 長さ 0・途中で切れたレコード・知らない型番号に当たったらそこで終わりとする
+  void scan(std::string_view view) {
+    stride_ = JournalOptions{}.index_stride;
+    size_t offset = detail::kHeaderSize;
+    uint64_t count = 0;
+    while (auto length = record_length(view, offset)) {
+      uint8_t type = static_cast<uint8_t>(view[offset + sizeof(uint32_t)]);
+      if (type >= sizeof...(Events)) {
+        break;
+      }
+      if (count % stride_ == 0) {
+        index_.push_back(offset);
+      }
+      offset += sizeof(uint32_t) + *length;
+      ++count;
+    }
+    data_ = view.substr(0, offset);
+    count_ = count;
+  }
+
+  bool fail(std::string message) {
+    error_ = std::move(message);
+    return false;
+  }
+
+  detail::ReadOnlyMapping file_;
+  std::string_view data_;  // ヘッダからレコード部の終端まで
+  uint64_t count_ = 0;
+  uint32_t stride_ = 1;
+  std::vector<uint64_t> index_;
+  bool recovered_ = false;
+  std::string error_;
+};
+
+// std::variant<A, B, C> から JournalWriter<A, B, C> / JournalReader<A, B, C> を作る
+template <typename Variant>
+struct JournalFor;
+
+template <typename... Events>
+struct JournalFor<std::variant<Events...>> {
+  using Writer = JournalWriter<Events...>;
+  using Reader = JournalReader<Events...>;
+};
+
+}  // namespace events
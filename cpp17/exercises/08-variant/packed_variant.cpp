@@ -0,0 +1,267 @@
+// packed_variant.h のサンプルとベンチマーク
+//   - PackedVariant / VariantVector の使い方
+//   - 1千万要素の配列で std::variant とメモリ量・走査時間を比べる
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include "packed_variant.h"
+
+template <class... Ts>
+struct overloaded : Ts... {
+  using Ts::operator()...;
+};
+template <class... Ts>
+overloaded(Ts...) -> overloaded<Ts...>;
+
+// GameEvent の文字列を ID にした、トリビアルにコピーできる版
+struct PlayerMoved {
+  float x;
+  float y;
+};
+struct ItemPickedUp {
+  int32_t item_id;
+  uint16_t name_id;
+};
+struct DamageTaken {
+  int32_t amount;
+  uint16_t source_id;
+};
+
+using Number = std::variant<int32_t, int64_t, double>;
+using PackedNumber = compact::PackedVariant<int32_t, int64_t, double>;
+using NumberColumn = compact::VariantVector<int32_t, int64_t, double>;
+
+using Event = std::variant<PlayerMoved, ItemPickedUp, DamageTaken>;
+using PackedEvent = compact::PackedVariant<PlayerMoved, ItemPickedUp, DamageTaken>;
+
+static_assert(sizeof(PackedNumber) == sizeof(double) + 1);
+static_assert(sizeof(PackedEvent) == sizeof(PlayerMoved) + 1);
+static_assert(alignof(PackedEvent) == 1);
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 詰めて並べる variant ===" << std::endl;
+
+  std::cout << "sizeof: std::variant<int32,int64,double>=" << sizeof(Number)
+            << " PackedVariant=" << sizeof(PackedNumber)
+            << " / std::variant<イベント>=" << sizeof(Event)
+            << " PackedVariant=" << sizeof(PackedEvent) << std::endl;
+
+  std::vector<PackedNumber> numbers = {int32_t{42}, 3.14, int64_t{1} << 40};
+  for (const auto& number : numbers) {
+    number.visit(overloaded{
+        [](int32_t v) { std::cout << "int32: " << v << std::endl; },
+        [](int64_t v) { std::cout << "int64: " << v << std::endl; },
+        [](double v) { std::cout << "double: " << v << std::endl; }});
+  }
+  if (auto value = numbers[1].get_if<double>()) {
+    std::cout << "numbers[1] は double: " << *value << std::endl;
+  }
+  try {
+    numbers[0].get<double>();
+  } catch (const std::bad_variant_access&) {
+    std::cout << "numbers[0] は double ではない" << std::endl;
+  }
+  Number converted = numbers[2].to_std();
+  std::cout << "std::variant に戻すと index=" << converted.index() << std::endl;
+
+  std::cout << std::endl << "=== 型が配列全体で1つの VariantVector ===" << std::endl;
+  NumberColumn column(std::vector<double>{1.5, 2.5, 3.0});
+  double sum = column.visit([](auto values) {
+    double total = 0;
+    for (auto v : values) {
+      total += static_cast<double>(v);
+    }
+    return total;
+  });
+  std::cout << "double の列: " << column.size() << " 要素, 合計 " << sum
+            << std::endl;
+  column.reset<int32_t>() = {1, 2, 3, 4};
+  std::cout << "int32 の列に作り直した: index=" << column.index()
+            << " size=" << column.size() << std::endl;
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. ベンチマーク
+// ============================================================================
+
+template <typename Func>
+void measure(const char* label, size_t bytes, int repeats, Func&& func) {
+  double result = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; ++i) {
+    result += func();
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << "  " << label << ": " << bytes / (1 << 20) << " MB, "
+            << elapsed.count() / repeats << " ms/回 (checksum " << result
+            << ")" << std::endl;
+}
+
+// i 番目の数値（7割 int32、2割 double、1割 int64）
+Number make_number(size_t i) {
+  uint32_t roll = (static_cast<uint32_t>(i) * 2654435761u >> 8) % 10;
+  if (roll < 7) {
+    return static_cast<int32_t>(i % 1000);
+  }
+  if (roll < 9) {
+    return static_cast<double>(i % 1000) * 0.5;
+  }
+  return static_cast<int64_t>(i % 1000) << 33;
+}
+
+Event make_event(size_t i) {
+  uint32_t roll = (static_cast<uint32_t>(i) * 2654435761u >> 8) % 20;
+  if (roll < 16) {
+    return PlayerMoved{static_cast<float>(i % 100), 1.0f};
+  }
+  if (roll < 19) {
+    return DamageTaken{static_cast<int32_t>(i % 50), 3};
+  }
+  return ItemPickedUp{static_cast<int32_t>(i % 500), 7};
+}
+
+// 数値の合計（どの表現でも同じ計算）
+struct NumberSum {
+  double operator()(int32_t v) const { return v; }
+  double operator()(int64_t v) const { return static_cast<double>(v >> 33); }
+  double operator()(double v) const { return v; }
+};
+
+struct EventWeight {
+  double operator()(const PlayerMoved& e) const { return e.x + e.y; }
+  double operator()(const ItemPickedUp& e) const { return e.item_id; }
+  double operator()(const DamageTaken& e) const { return e.amount; }
+};
+
+void benchmark_example() {
+  constexpr size_t kCount = 10000000;
+  std::cout << "=== ベンチマーク（" << kCount << " 要素）===" << std::endl;
+
+  std::cout << "[数値が混ざった配列]" << std::endl;
+  {
+    std::vector<Number> values(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      values[i] = make_number(i);
+    }
+    measure("std::variant   ", values.size() * sizeof(Number), 10, [&] {
+      double sum = 0;
+      for (const auto& value : values) {
+        sum += std::visit(NumberSum{}, value);
+      }
+      return sum;
+    });
+  }
+  {
+    std::vector<PackedNumber> values(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      std::visit([&](auto v) { values[i].set(v); }, make_number(i));
+    }
+    measure("PackedVariant  ", values.size() * sizeof(PackedNumber), 10, [&] {
+      double sum = 0;
+      for (const auto& value : values) {
+        sum += value.visit(NumberSum{});
+      }
+      return sum;
+    });
+  }
+
+  std::cout << "[全部 double の列]" << std::endl;
+  {
+    std::vector<Number> values(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      values[i] = static_cast<double>(i % 1000) * 0.5;
+    }
+    measure("std::variant   ", values.size() * sizeof(Number), 10, [&] {
+      double sum = 0;
+      for (const auto& value : values) {
+        sum += std::visit(NumberSum{}, value);
+      }
+      return sum;
+    });
+  }
+  {
+    std::vector<PackedNumber> values(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      values[i].set(static_cast<double>(i % 1000) * 0.5);
+    }
+    measure("PackedVariant  ", values.size() * sizeof(PackedNumber), 10, [&] {
+      double sum = 0;
+      for (const auto& value : values) {
+        sum += value.visit(NumberSum{});
+      }
+      return sum;
+    });
+  }
+  {
+    NumberColumn column;
+    auto& values = column.reset<double>();
+    values.resize(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      values[i] = static_cast<double>(i % 1000) * 0.5;
+    }
+    measure("VariantVector  ", column.size() * sizeof(double), 10, [&] {
+      return column.visit([](auto span) {
+        double sum = 0;
+        for (auto v : span) {
+          sum += NumberSum{}(v);
+        }
+        return sum;
+      });
+    });
+  }
+
+  std::cout << "[イベント（文字列を ID にしたもの）]" << std::endl;
+  {
+    std::vector<Event> events(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      events[i] = make_event(i);
+    }
+    measure("std::variant   ", events.size() * sizeof(Event), 10, [&] {
+      double sum = 0;
+      for (const auto& event : events) {
+        sum += std::visit(EventWeight{}, event);
+      }
+      return sum;
+    });
+  }
+  {
+    std::vector<PackedEvent> events(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      std::visit([&](const auto& e) { events[i].set(e); }, make_event(i));
+    }
+    measure("PackedVariant  ", events.size() * sizeof(PackedEvent), 10, [&] {
+      double sum = 0;
+      for (const auto& event : events) {
+        sum += event.visit(EventWeight{});
+      }
+      return sum;
+    });
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "詰めて並べる variant と variant の配列のサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
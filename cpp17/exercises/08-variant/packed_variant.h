@@ -0,0 +1,212 @@
+// 詰めて並べる variant と、型ごとにまとめて持つ variant の配列
+// std::variant の型番号は libstdc++ では既に1バイト（選択肢が 255 個以下のとき）だが、
+// 全体のアラインメントが一番厳しい選択肢に合わせられるので、
+// std::variant<int32_t, float> は 8 バイト、std::variant<int32_t, double> は 16 バイトになり、
+// 型番号の1バイトのために最大7バイトの詰め物が付く。ここでは
+//   - PackedVariant<Ts...>: アラインメント 1 のバイト列に値を memcpy で出し入れし、
+//     sizeof = 一番大きい選択肢 + 1 バイト（型番号 uint8_t）にする
+//     （そのためトリビアルにコピーできる型に限る。値は参照ではなくコピーで返す）
+//   - VariantVector<Ts...>: 要素が全部同じ型になる大きな配列は std::variant<std::vector<Ts>...>
+//     として持ち、型番号を配列全体で1つにする（要素あたり sizeof(T) バイト）
+// を用意する。std::string などを含む variant の列は、型ごとに分けて持つ
+// （event_bus.h のような）形にするほうがよい。
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace compact {
+
+namespace detail {
+
+template <typename T, typename... Ts>
+constexpr size_t index_of() {
+  constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+  for (size_t i = 0; i < sizeof...(Ts); ++i) {
+    if (matches[i]) {
+      return i;
+    }
+  }
+  return sizeof...(Ts);
+}
+
+template <typename T, typename... Ts>
+inline constexpr bool contains_v = (std::is_same_v<T, Ts> || ...);
+
+}  // namespace detail
+
+// ============================================================================
+// PackedVariant
+// ============================================================================
+
+template <typename... Ts>
+class PackedVariant {
+  static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= 255,
+                "選択肢は 1〜255 個");
+  static_assert((std::is_trivially_copyable_v<Ts> && ...),
+                "詰めて持てるのはトリビアルにコピーできる型だけ");
+
+ public:
+  static constexpr size_t kStorageSize = std::max({sizeof(Ts)...});
+
+  // std::variant と同じく、最初の選択肢を値初期化した状態で始まる
+  PackedVariant() noexcept { store<0>(first_type{}); }
+
+  template <typename T, typename = std::enable_if_t<
+                            detail::contains_v<std::decay_t<T>, Ts...>>>
+  PackedVariant(const T& value) noexcept {
+    set(value);
+  }
+
+  size_t index() const noexcept { return index_; }
+
+  template <typename T>
+  bool holds() const noexcept {
+    return index_ == detail::index_of<T, Ts...>();
+  }
+
+  template <typename T>
+  void set(const T& value) noexcept {
+    constexpr size_t kIndex = detail::index_of<T, Ts...>();
+    static_assert(kIndex < sizeof...(Ts), "選択肢にない型です");
+    store<kIndex>(value);
+  }
+
+  // 値をコピーで取り出す。型が違えば std::bad_variant_access
+  template <typename T>
+  T get() const {
+    if (!holds<T>()) {
+      throw std::bad_variant_access();
+    }
+    return load<T>();
+  }
+
+  template <typename T>
+  std::optional<T> get_if() const noexcept {
+    return holds<T>() ? std::optional<T>(load<T>()) : std::nullopt;
+  }
+
+  // func には今の選択肢の値（コピー）が渡る。
+  // 型番号の比較を並べるだけなので、選択肢が少なければインライン展開される
+  template <typename Func>
+  decltype(auto) visit(Func&& func) const {
+    return visit_from<0>(func);
+  }
+
+  std::variant<Ts...> to_std() const {
+    return visit([](auto value) { return std::variant<Ts...>(value); });
+  }
+
+ private:
+  using first_type = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+  template <size_t I, typename T>
+  void store(const T& value) noexcept {
+    std::memcpy(storage_, &value, sizeof(T));
+    index_ = static_cast<uint8_t>(I);
+  }
+
+  template <typename T>
+  T load() const noexcept {
+    T value;
+    std::memcpy(&value, storage_, sizeof(T));
+    return value;
+  }
+
+  template <size_t I, typename Func>
+  decltype(auto) visit_from(Func& func) const {
+    using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+    if constexpr (I + 1 == sizeof...(Ts)) {
+      return func(load<T>());
+    } else {
+      if (index_ == I) {
+        return func(load<T>());
+      }
+      return visit_from<I + 1>(func);
+    }
+  }
+
+  unsigned char storage_[kStorageSize];
+  uint8_t index_;
+};
+
+template <typename Func, typename... Ts>
+decltype(auto) visit(Func&& func, const PackedVariant<Ts...>& value) {
+  return value.visit(std::forward<Func>(func));
+}
+
+// ============================================================================
+// VariantVector（要素の型が配列全体で1つに決まる配列）
+// ============================================================================
+
+template <typename... Ts>
+class VariantVector {
+ public:
+  VariantVector() = default;
+
+  template <typename T>
+  explicit VariantVector(std::vector<T> values) : values_(std::move(values)) {}
+
+  // T の配列として作り直す（中身は空）
+  template <typename T>
+  std::vector<T>& reset() {
+    return values_.template emplace<std::vector<T>>();
+  }
+
+  size_t index() const noexcept { return values_.index(); }
+
+  template <typename T>
+  bool holds() const noexcept {
+    return std::holds_alternative<std::vector<T>>(values_);
+  }
+
+  template <typename T>
+  std::vector<T>& get() {
+    return std::get<std::vector<T>>(values_);
+  }
+  template <typename T>
+  const std::vector<T>& get() const {
+    return std::get<std::vector<T>>(values_);
+  }
+
+  size_t size() const {
+    return std::visit([](const auto& values) { return values.size(); },
+                      values_);
+  }
+
+  // func には配列全体が std::span<const T> で渡る（型の分岐は1回だけ）
+  template <typename Func>
+  decltype(auto) visit(Func&& func) const {
+    return std::visit(
+        [&](const auto& values) {
+          using T = typename std::decay_t<decltype(values)>::value_type;
+          return func(std::span<const T>(values));
+        },
+        values_);
+  }
+
+  template <typename Func>
+  decltype(auto) visit(Func&& func) {
+    return std::visit(
+        [&](auto& values) {
+          using T = typename std::decay_t<decltype(values)>::value_type;
+          return func(std::span<T>(values));
+        },
+        values_);
+  }
+
+ private:
+  std::variant<std::vector<Ts>...> values_;
+};
+
+}  // namespace compact
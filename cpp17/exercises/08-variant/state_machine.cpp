@@ -0,0 +1,285 @@
+// state_machine.h のサンプルとベンチマーク
+//   - 見張りの AI（待機 → 移動 → 攻撃 → 待機）を遷移表で定義する
+//   - example.cpp と同じ 1体ずつの std::visit との照合
+//   - 100万体での1ティックあたりの時間
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include "state_machine.h"
+
+template <class... Ts>
+struct overloaded : Ts... {
+  using Ts::operator()...;
+};
+template <class... Ts>
+overloaded(Ts...) -> overloaded<Ts...>;
+
+// ============================================================================
+// 状態に入るときの値（どちらの実装でも同じものを使う）
+// ============================================================================
+
+uint32_t mix(uint32_t agent, uint32_t tick) {
+  uint32_t x = agent * 0x9E3779B1u ^ tick * 0x85EBCA77u;
+  x ^= x >> 15;
+  x *= 0x2C1B3C6Du;
+  x ^= x >> 12;
+  return x;
+}
+
+float rest_time(uint32_t agent, uint32_t tick) {
+  return 0.5f + static_cast<float>(mix(agent, tick) % 16) * 0.1f;
+}
+float move_velocity(uint32_t agent, uint32_t tick) {
+  return 2.0f + static_cast<float>(mix(agent, tick) % 4);
+}
+float move_distance(uint32_t agent, uint32_t tick) {
+  return 1.0f + static_cast<float>(mix(agent, tick) >> 8 & 15) * 0.125f;
+}
+int32_t attack_damage(uint32_t agent, uint32_t tick) {
+  return 1 + static_cast<int32_t>(mix(agent, tick) % 10);
+}
+int32_t attack_hits(uint32_t agent, uint32_t tick) {
+  return 2 + static_cast<int32_t>(mix(agent, tick) >> 8 & 3);
+}
+
+// ============================================================================
+// 状態マシンの定義
+// ============================================================================
+
+struct Idle : fsm::State<float> {
+  enum Field { kRest };  // 残りの休憩時間
+};
+struct Moving : fsm::State<float, float> {
+  enum Field { kVelocity, kDistance };
+};
+struct Attacking : fsm::State<int32_t, int32_t> {
+  enum Field { kDamage, kHitsLeft };
+};
+
+struct GuardMachine {
+  using States = fsm::StateList<Idle, Moving, Attacking>;
+  enum class Event : uint8_t { kNone, kRested, kArrived, kFinished, kCount };
+
+  struct Context {
+    float dt = 0.1f;
+    uint32_t tick = 0;
+    int64_t damage_dealt = 0;
+  };
+
+  static constexpr fsm::Transition<Event> kTransitions[] = {
+      {fsm::index_of<Idle, States>, Event::kRested, fsm::index_of<Moving, States>},
+      {fsm::index_of<Moving, States>, Event::kArrived,
+       fsm::index_of<Attacking, States>},
+      {fsm::index_of<Attacking, States>, Event::kFinished,
+       fsm::index_of<Idle, States>},
+  };
+
+  // 状態ごとに、バケツの列をまとめて更新する
+  static void update(fsm::Bucket<Idle>& bucket, std::span<Event> events,
+                     Context& context) {
+    auto& rest = bucket.column<Idle::kRest>();
+    for (size_t i = 0; i < rest.size(); ++i) {
+      rest[i] -= context.dt;
+      events[i] = rest[i] <= 0 ? Event::kRested : Event::kNone;
+    }
+  }
+
+  static void update(fsm::Bucket<Moving>& bucket, std::span<Event> events,
+                     Context& context) {
+    const auto& velocity = bucket.column<Moving::kVelocity>();
+    auto& distance = bucket.column<Moving::kDistance>();
+    for (size_t i = 0; i < distance.size(); ++i) {
+      distance[i] -= velocity[i] * context.dt;
+      events[i] = distance[i] <= 0 ? Event::kArrived : Event::kNone;
+    }
+  }
+
+  static void update(fsm::Bucket<Attacking>& bucket, std::span<Event> events,
+                     Context& context) {
+    const auto& damage = bucket.column<Attacking::kDamage>();
+    auto& hits_left = bucket.column<Attacking::kHitsLeft>();
+    int64_t dealt = 0;
+    for (size_t i = 0; i < hits_left.size(); ++i) {
+      dealt += damage[i];
+      hits_left[i] -= 1;
+      events[i] = hits_left[i] == 0 ? Event::kFinished : Event::kNone;
+    }
+    context.damage_dealt += dealt;
+  }
+
+  // 状態に入るときの値
+  static Idle::Row enter(fsm::Tag<Idle>, uint32_t agent, Event,
+                         const Context& context) {
+    return {rest_time(agent, context.tick)};
+  }
+  static Moving::Row enter(fsm::Tag<Moving>, uint32_t agent, Event,
+                           const Context& context) {
+    return {move_velocity(agent, context.tick), move_distance(agent, context.tick)};
+  }
+  static Attacking::Row enter(fsm::Tag<Attacking>, uint32_t agent, Event,
+                              const Context& context) {
+    return {attack_damage(agent, context.tick), attack_hits(agent, context.tick)};
+  }
+};
+
+using GuardPool = fsm::AgentPool<GuardMachine>;
+using Event = GuardMachine::Event;
+
+// 遷移表はコンパイル時に引ける
+static_assert(GuardPool::next_state(fsm::index_of<Idle, GuardMachine::States>,
+                                    Event::kRested) ==
+              fsm::index_of<Moving, GuardMachine::States>);
+static_assert(GuardPool::next_state(fsm::index_of<Idle, GuardMachine::States>,
+                                    Event::kArrived) == GuardPool::kNoTransition);
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 状態ごとのバケツで動かす ===" << std::endl;
+
+  GuardPool pool;
+  GuardMachine::Context context;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    pool.spawn<Idle>({rest_time(i, 0)});
+  }
+  for (context.tick = 1; context.tick <= 30; ++context.tick) {
+    pool.tick(context);
+    if (context.tick % 5 == 0) {
+      std::cout << "tick " << context.tick << ": Idle=" << pool.count<Idle>()
+                << " Moving=" << pool.count<Moving>()
+                << " Attacking=" << pool.count<Attacking>()
+                << " 遷移=" << pool.transitions()
+                << " 与ダメージ累計=" << context.damage_dealt << std::endl;
+    }
+  }
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. 比較用: example.cpp と同じ 1体ずつの std::visit
+// ============================================================================
+
+struct IdleState {
+  float rest;
+};
+struct MovingState {
+  float velocity;
+  float distance;
+};
+struct AttackingState {
+  int32_t damage;
+  int32_t hits_left;
+};
+
+using AgentState = std::variant<IdleState, MovingState, AttackingState>;
+
+void visit_tick(std::vector<AgentState>& agents, GuardMachine::Context& context) {
+  for (size_t i = 0; i < agents.size(); ++i) {
+    auto agent = static_cast<uint32_t>(i);
+    Event event = std::visit(
+        overloaded{[&](IdleState& s) {
+                     s.rest -= context.dt;
+                     return s.rest <= 0 ? Event::kRested : Event::kNone;
+                   },
+                   [&](MovingState& s) {
+                     s.distance -= s.velocity * context.dt;
+                     return s.distance <= 0 ? Event::kArrived : Event::kNone;
+                   },
+                   [&](AttackingState& s) {
+                     context.damage_dealt += s.damage;
+                     s.hits_left -= 1;
+                     return s.hits_left == 0 ? Event::kFinished : Event::kNone;
+                   }},
+        agents[i]);
+    switch (event) {
+      case Event::kRested:
+        agents[i] = MovingState{move_velocity(agent, context.tick),
+                                move_distance(agent, context.tick)};
+        break;
+      case Event::kArrived:
+        agents[i] = AttackingState{attack_damage(agent, context.tick),
+                                   attack_hits(agent, context.tick)};
+        break;
+      case Event::kFinished:
+        agents[i] = IdleState{rest_time(agent, context.tick)};
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// ============================================================================
+// 3. ベンチマーク
+// ============================================================================
+
+void benchmark_example() {
+  constexpr uint32_t kAgents = 1000000;
+  constexpr uint32_t kTicks = 100;
+  std::cout << "=== ベンチマーク（" << kAgents << " 体 × " << kTicks
+            << " ティック）===" << std::endl;
+
+  using Millis = std::chrono::duration<double, std::milli>;
+
+  std::vector<AgentState> agents;
+  agents.reserve(kAgents);
+  for (uint32_t i = 0; i < kAgents; ++i) {
+    agents.emplace_back(IdleState{rest_time(i, 0)});
+  }
+  GuardMachine::Context visit_context;
+  auto begin = std::chrono::steady_clock::now();
+  for (visit_context.tick = 1; visit_context.tick <= kTicks; ++visit_context.tick) {
+    visit_tick(agents, visit_context);
+  }
+  Millis visit_time = std::chrono::steady_clock::now() - begin;
+  std::cout << "1体ずつ std::visit      : " << visit_time.count() / kTicks
+            << " ms/ティック (与ダメージ " << visit_context.damage_dealt << ")"
+            << std::endl;
+
+  GuardPool pool;
+  pool.reserve<Idle>(kAgents);
+  pool.reserve<Moving>(kAgents);
+  pool.reserve<Attacking>(kAgents);
+  for (uint32_t i = 0; i < kAgents; ++i) {
+    pool.spawn<Idle>({rest_time(i, 0)});
+  }
+  GuardMachine::Context pool_context;
+  size_t transitions = 0;
+  begin = std::chrono::steady_clock::now();
+  for (pool_context.tick = 1; pool_context.tick <= kTicks; ++pool_context.tick) {
+    pool.tick(pool_context);
+    transitions += pool.transitions();
+  }
+  Millis pool_time = std::chrono::steady_clock::now() - begin;
+  std::cout << "状態ごとのバケツ（SoA） : " << pool_time.count() / kTicks
+            << " ms/ティック (与ダメージ " << pool_context.damage_dealt
+            << ", 遷移 " << transitions / kTicks << " 件/ティック)" << std::endl;
+
+  // 全エージェントの状態と与ダメージが一致するか
+  size_t mismatches = visit_context.damage_dealt != pool_context.damage_dealt;
+  for (uint32_t i = 0; i < kAgents; ++i) {
+    mismatches += agents[i].index() != pool.state_of(i);
+  }
+  std::cout << "不一致: " << mismatches << std::endl << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "遷移表と状態ごとのバケツによる状態マシンのサンプル\n" << std::endl;
+
+  basic_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,308 @@
+// 大量のエージェントを状態ごとにまとめて動かす状態マシン
+// example.cpp の GameState（std::variant）はエージェント1体ごとに std::visit で
+// 分岐し、状態が変わるたびに別の型を代入する。数万〜数百万体になると
+//   - 1体ごとに variant のタグで間接分岐し
+//   - 状態の違うエージェントが交互に並ぶので、同じ処理が連続しない
+// ので遅い。ここでは
+//   - 状態の型と遷移表をコンパイル時に与え（遷移表は constexpr の2次元配列）
+//   - エージェントは状態ごとのバケツに入れ、バケツは列ごとの配列（SoA）で持ち
+//   - 1ティックは「状態ごとにバケツ全体を1回の関数呼び出しで更新し、
+//     イベントを出す」→「イベントを遷移表で引き、バケツ間を移す」の2段で進める
+// とする。分岐は状態ごとに1回で、更新のループは同じ型の列を順に読むだけになる。
+//
+// 状態マシンの定義（Machine）に必要なもの:
+//   using States = fsm::StateList<A, B, ...>;
+//   enum class Event : uint8_t { kNone, ..., kCount };   // kNone は「遷移しない」
+//   static constexpr fsm::Transition<Event> kTransitions[] = {
+//       {fsm::index_of<A, States>, Event::kX, fsm::index_of<B, States>}, ...};
+//   using Context = ...;                                  // tick に渡すもの
+//   static void update(fsm::Bucket<A>&, std::span<Event>, Context&);  // 状態ごと
+//   static A::Row enter(fsm::Tag<A>, uint32_t agent, Event, const Context&);
+// 状態の型は fsm::State<列の型...> を継承し、列の並びを宣言する。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fsm {
+
+// 状態の列の並び（例: struct Moving : State<float, float> {}）
+template <typename... Fields>
+struct State {
+  using Row = std::tuple<Fields...>;
+};
+
+template <typename... States>
+struct StateList {};
+
+template <typename S>
+struct Tag {};
+
+namespace detail {
+
+template <typename S, typename... States>
+constexpr size_t index_in() {
+  constexpr bool matches[] = {std::is_same_v<S, States>...};
+  for (size_t i = 0; i < sizeof...(States); ++i) {
+    if (matches[i]) {
+      return i;
+    }
+  }
+  return sizeof...(States);
+}
+
+template <typename S, typename List>
+struct IndexOf;
+
+template <typename S, typename... States>
+struct IndexOf<S, StateList<States...>> {
+  static constexpr size_t value = index_in<S, States...>();
+  static_assert(value < sizeof...(States), "StateList にない状態です");
+};
+
+template <typename Row>
+struct Columns;
+
+template <typename... Fields>
+struct Columns<std::tuple<Fields...>> {
+  using type = std::tuple<std::vector<Fields>...>;
+};
+
+}  // namespace detail
+
+template <typename S, typename List>
+inline constexpr uint8_t index_of =
+    static_cast<uint8_t>(detail::IndexOf<S, List>::value);
+
+// 遷移表の1行: from の状態で event が出たら to へ移る
+template <typename Event>
+struct Transition {
+  uint8_t from;
+  Event event;
+  uint8_t to;
+};
+
+// ============================================================================
+// 状態ごとのバケツ（列ごとの配列）
+// ============================================================================
+
+template <typename S>
+class Bucket {
+ public:
+  using Row = typename S::Row;
+
+  size_t size() const { return ids_.size(); }
+  std::span<const uint32_t> ids() const { return ids_; }
+
+  // F 番目の列
+  template <size_t F>
+  auto& column() {
+    return std::get<F>(columns_);
+  }
+  template <size_t F>
+  const auto& column() const {
+    return std::get<F>(columns_);
+  }
+
+  // 末尾に追加し、その行番号を返す
+  size_t push(uint32_t agent, const Row& row) {
+    ids_.push_back(agent);
+    push_columns(row, std::make_index_sequence<std::tuple_size_v<Row>>{});
+    return ids_.size() - 1;
+  }
+
+  // row を末尾と入れ替えて消す。row に移ってきたエージェントを返す
+  // （row が末尾だったときは消したエージェント自身）
+  uint32_t swap_remove(size_t row) {
+    uint32_t moved = ids_.back();
+    ids_[row] = moved;
+    ids_.pop_back();
+    std::apply(
+        [row](auto&... column) {
+          ((column[row] = column.back(), column.pop_back()), ...);
+        },
+        columns_);
+    return moved;
+  }
+
+  void reserve(size_t count) {
+    ids_.reserve(count);
+    std::apply([count](auto&... column) { (column.reserve(count), ...); },
+               columns_);
+  }
+
+ private:
+  template <size_t... Fs>
+  void push_columns(const Row& row, std::index_sequence<Fs...>) {
+    (std::get<Fs>(columns_).push_back(std::get<Fs>(row)), ...);
+  }
+
+  std::vector<uint32_t> ids_;
+  typename detail::Columns<Row>::type columns_;
+};
+
+// ============================================================================
+// エージェントの集まり
+// ============================================================================
+
+template <typename Machine, typename List = typename Machine::States>
+class AgentPool;
+
+template <typename Machine, typename... States>
+class AgentPool<Machine, StateList<States...>> {
+ public:
+  using Event = typename Machine::Event;
+  using Context = typename Machine::Context;
+  static constexpr size_t kStateCount = sizeof...(States);
+  static constexpr size_t kEventCount = static_cast<size_t>(Event::kCount);
+  static constexpr uint8_t kNoTransition = 0xFF;
+
+  static_assert(kStateCount < kNoTransition, "状態が多すぎます");
+  static_assert(static_cast<size_t>(Event::kNone) == 0,
+                "Event::kNone は 0 にする");
+
+ private:
+  // 遷移表に矛盾がないか（コンパイル時に調べる）
+  static constexpr bool transitions_valid() {
+    bool seen[kStateCount][kEventCount] = {};
+    for (const auto& t : Machine::kTransitions) {
+      auto event = static_cast<size_t>(t.event);
+      if (t.from >= kStateCount || t.to >= kStateCount || event == 0 ||
+          event >= kEventCount || seen[t.from][event]) {
+        return false;
+      }
+      seen[t.from][event] = true;
+    }
+    return true;
+  }
+  static_assert(transitions_valid(),
+                "遷移表に範囲外・kNone・重複した行があります");
+
+  static constexpr auto kTable = [] {
+    std::array<std::array<uint8_t, kEventCount>, kStateCount> table{};
+    for (auto& row : table) {
+      for (auto& to : row) {
+        to = kNoTransition;
+      }
+    }
+    for (const auto& t : Machine::kTransitions) {
+      table[t.from][static_cast<size_t>(t.event)] = t.to;
+    }
+    return table;
+  }();
+
+ public:
+  // from の状態で event が出たときの行き先（遷移しないなら kNoTransition）
+  static constexpr uint8_t next_state(size_t from, Event event) {
+    return kTable[from][static_cast<size_t>(event)];
+  }
+
+  template <typename S>
+  uint32_t spawn(const typename S::Row& row) {
+    constexpr uint8_t kState = index_of<S, StateList<States...>>;
+    auto agent = static_cast<uint32_t>(where_.size());
+    size_t position = bucket<S>().push(agent, row);
+    where_.push_back({kState, static_cast<uint32_t>(position)});
+    return agent;
+  }
+
+  // 1ティック進める
+  void tick(Context& context) {
+    transitions_ = 0;
+    (update_state<States>(context), ...);
+    (apply_state<States>(context), ...);
+  }
+
+  template <typename S>
+  Bucket<S>& bucket() {
+    return std::get<Bucket<S>>(buckets_);
+  }
+  template <typename S>
+  const Bucket<S>& bucket() const {
+    return std::get<Bucket<S>>(buckets_);
+  }
+
+  template <typename S>
+  size_t count() const {
+    return bucket<S>().size();
+  }
+
+  // agent の今の状態（StateList での番号）
+  size_t state_of(uint32_t agent) const { return where_[agent].state; }
+
+  size_t size() const { return where_.size(); }
+  // 直前の tick で遷移した数
+  size_t transitions() const { return transitions_; }
+
+  template <typename S>
+  void reserve(size_t count) {
+    bucket<S>().reserve(count);
+  }
+
+ private:
+  struct Location {
+    uint8_t state;
+    uint32_t row;
+  };
+
+  using Enter = void (*)(AgentPool&, uint32_t, Event, const Context&);
+
+  template <typename S>
+  void update_state(Context& context) {
+    constexpr size_t kState = index_of<S, StateList<States...>>;
+    auto& events = events_[kState];
+    events.assign(bucket<S>().size(), Event::kNone);
+    Machine::update(bucket<S>(), std::span<Event>(events), context);
+  }
+
+  template <typename T>
+  static void enter_state(AgentPool& pool, uint32_t agent, Event event,
+                          const Context& context) {
+    constexpr uint8_t kState = index_of<T, StateList<States...>>;
+    size_t row =
+        pool.bucket<T>().push(agent, Machine::enter(Tag<T>{}, agent, event, context));
+    pool.where_[agent] = {kState, static_cast<uint32_t>(row)};
+  }
+
+  static constexpr std::array<Enter, kStateCount> kEnter = {
+      &enter_state<States>...};
+
+  // 後ろから処理するので、swap_remove で前に来るのは処理済みの行か、
+  // この tick で入ってきた（イベントを持たない）行だけになる
+  template <typename S>
+  void apply_state(const Context& context) {
+    constexpr size_t kState = index_of<S, StateList<States...>>;
+    const auto& events = events_[kState];
+    Bucket<S>& from = bucket<S>();
+    for (size_t i = events.size(); i-- > 0;) {
+      if (events[i] == Event::kNone) {
+        continue;
+      }
+      uint8_t to = kTable[kState][static_cast<size_t>(events[i])];
+      if (to == kNoTransition) {
+        continue;
+      }
+      uint32_t agent = from.ids()[i];
+      kEnter[to](*this, agent, events[i], context);
+      uint32_t moved = from.swap_remove(i);
+      if (moved != agent || to == kState) {
+        where_[moved].row = static_cast<uint32_t>(i);
+      }
+      ++transitions_;
+    }
+  }
+
+  std::tuple<Bucket<States>...> buckets_;
+  std::array<std::vector<Event>, kStateCount> events_;
+  std::vector<Location> where_;
+  size_t transitions_ = 0;
+};
+
+}  // namespace fsm
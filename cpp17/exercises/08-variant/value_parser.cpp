@@ -0,0 +1,303 @@
+// value_parser.h のサンプルとベンチマーク
+//   - 例外を使わない parse_value と列の型推論
+//   - solution.cpp の parse_value（stoi / stod + try/catch）との照合
+//   - 整数・浮動小数点・文字列の多い列での比較（100万セル）
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "value_parser.h"
+
+template <class... Ts>
+struct overloaded : Ts... {
+  using Ts::operator()...;
+};
+template <class... Ts>
+overloaded(Ts...) -> overloaded<Ts...>;
+
+void print_result(const parse::ParseResult& result) {
+  std::visit(
+      overloaded{
+          [](const parse::IntValue& v) {
+            std::cout << "Integer: " << v.value << std::endl;
+          },
+          [](const parse::FloatValue& v) {
+            std::cout << "Float: " << v.value << std::endl;
+          },
+          [](const parse::StringValue& v) {
+            std::cout << "String: " << v.value << std::endl;
+          },
+          [](const parse::ParseError& e) {
+            std::cout << "Error: " << e.error_message << std::endl;
+          }},
+      result);
+}
+
+// ============================================================================
+// 1. 基本的な使い方
+// ============================================================================
+
+void basic_example() {
+  std::cout << "=== 例外を使わない parse_value ===" << std::endl;
+
+  for (std::string_view input :
+       {"42", "3.14", "hello", "", "123", "+7", "-1e3", "9999999999", "12abc"}) {
+    std::cout << "\"" << input << "\" -> ";
+    print_result(parse::parse_value(input));
+  }
+
+  std::cout << std::endl << "=== 列の型推論 ===" << std::endl;
+  std::vector<std::vector<std::string>> columns = {
+      {"1", "2", "", "4"},
+      {"1", "5000000000", "-3"},
+      {"1", "2.5", "3"},
+      {"10", "n/a", "30"},
+      {"", ""}};
+  for (const auto& cells : columns) {
+    parse::Column column = parse::parse_column(cells);
+    std::cout << parse::to_string(column.type) << ":";
+    std::visit(overloaded{[](std::monostate) {},
+                          [&](const auto& values) {
+                            for (size_t i = 0; i < values.size(); ++i) {
+                              std::cout << " ";
+                              if (column.is_valid(i)) {
+                                std::cout << values[i];
+                              } else {
+                                std::cout << "(空)";
+                              }
+                            }
+                          }},
+               column.values);
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. 比較用: solution.cpp と同じ parse_value
+// ============================================================================
+
+parse::ParseResult legacy_parse_value(const std::string& str) {
+  if (str.empty()) {
+    return parse::ParseError{"Empty string"};
+  }
+
+  // 整数として試みる
+  try {
+    size_t pos;
+    int i = std::stoi(str, &pos);
+    if (pos == str.length()) {
+      return parse::IntValue{i};
+    }
+  } catch (...) {
+  }
+
+  // 浮動小数点として試みる
+  try {
+    size_t pos;
+    double d = std::stod(str, &pos);
+    if (pos == str.length()) {
+      return parse::FloatValue{d};
+    }
+  } catch (...) {
+  }
+
+  return parse::StringValue{str};
+}
+
+bool same_result(const parse::ParseResult& a, const parse::ParseResult& b) {
+  if (a.index() != b.index()) {
+    return false;
+  }
+  return std::visit(
+      overloaded{[&](const parse::IntValue& v) {
+                   return v.value == std::get<parse::IntValue>(b).value;
+                 },
+                 [&](const parse::FloatValue& v) {
+                   return v.value == std::get<parse::FloatValue>(b).value;
+                 },
+                 [&](const parse::StringValue& v) {
+                   return v.value == std::get<parse::StringValue>(b).value;
+                 },
+                 [&](const parse::ParseError& e) {
+                   return e.error_message ==
+                          std::get<parse::ParseError>(b).error_message;
+                 }},
+      a);
+}
+
+// ============================================================================
+// 3. ランダムな入力で solution.cpp と照合
+// ============================================================================
+
+std::string random_cell(std::mt19937& rng) {
+  static const char* const kWords[] = {"hello", "Goblin", "n/a", "e", "-",
+                                       ".", "+", "1-2", "--5", "+-5", "12abc",
+                                       "1e", "1.2.3", "e5", "Sword of Kings"};
+  switch (rng() % 8) {
+    case 0:
+      return std::to_string(static_cast<int>(rng()));
+    case 1:
+      return std::to_string(static_cast<int64_t>(rng()) * 100000 - 7);
+    case 2:
+      return std::to_string(static_cast<double>(rng()) / 997);
+    case 3: {
+      std::uniform_real_distribution<double> dist(-1e6, 1e6);
+      char buffer[64];
+      auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer),
+                                        dist(rng), std::chars_format::scientific);
+      return std::string(buffer, end);
+    }
+    case 4:
+      return (rng() % 2 ? "+" : "-") + std::to_string(rng() % 100000);
+    case 5:
+      return "." + std::to_string(rng() % 1000);
+    case 6:
+      return std::string(20 + rng() % 10, static_cast<char>('1' + rng() % 9));
+    default:
+      return kWords[rng() % std::size(kWords)];
+  }
+}
+
+void verify_example() {
+  std::cout << "=== ランダムな入力で solution.cpp と照合 ===" << std::endl;
+
+  std::mt19937 rng(5);
+  size_t mismatches = 0;
+  constexpr int kCells = 200000;
+  for (int i = 0; i < kCells; ++i) {
+    std::string cell = random_cell(rng);
+    if (!same_result(legacy_parse_value(cell), parse::parse_value(cell))) {
+      if (mismatches++ < 5) {
+        std::cout << "  不一致: \"" << cell << "\"" << std::endl;
+      }
+    }
+  }
+  std::cout << kCells << " セル中 不一致 " << mismatches << std::endl << std::endl;
+}
+
+// ============================================================================
+// 4. ベンチマーク
+// ============================================================================
+
+std::vector<std::string> make_cells(size_t count, int text_percent,
+                                    bool fractions, unsigned seed) {
+  static const char* const kWords[] = {"Alice", "Bob", "Charlie", "n/a",
+                                       "Tokyo", "Osaka", "unknown",
+                                       "Health Potion", "Ancient Scroll"};
+  std::mt19937 rng(seed);
+  std::vector<std::string> cells;
+  cells.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (static_cast<int>(rng() % 100) < text_percent) {
+      cells.emplace_back(kWords[rng() % std::size(kWords)]);
+    } else if (fractions) {
+      cells.push_back(std::to_string(static_cast<double>(rng() % 1000000) / 100));
+    } else {
+      cells.push_back(std::to_string(static_cast<int>(rng() % 2000000) - 1000000));
+    }
+  }
+  return cells;
+}
+
+// solution.cpp の parse_value で1セルずつ読み、結果を並べる（比較用の列の読み込み）
+std::vector<parse::ParseResult> legacy_parse_column(
+    const std::vector<std::string>& cells) {
+  std::vector<parse::ParseResult> results;
+  results.reserve(cells.size());
+  for (const auto& cell : cells) {
+    results.push_back(legacy_parse_value(cell));
+  }
+  return results;
+}
+
+template <typename Func>
+void measure(const char* label, size_t cells, Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  long long checksum = func();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  std::cout << "  " << label << ": " << elapsed.count() / cells
+            << " ns/セル (checksum " << checksum << ")" << std::endl;
+}
+
+void benchmark_column(const char* name, const std::vector<std::string>& cells) {
+  std::cout << name << std::endl;
+  measure("solution.cpp parse_value   ", cells.size(), [&] {
+    long long checksum = 0;
+    for (const auto& cell : cells) {
+      checksum += static_cast<long long>(legacy_parse_value(cell).index());
+    }
+    return checksum;
+  });
+  measure("parse::parse_value         ", cells.size(), [&] {
+    long long checksum = 0;
+    for (const auto& cell : cells) {
+      checksum += static_cast<long long>(parse::parse_value(cell).index());
+    }
+    return checksum;
+  });
+  measure("parse::parse_scalar        ", cells.size(), [&] {
+    long long checksum = 0;
+    for (const auto& cell : cells) {
+      checksum += static_cast<long long>(parse::parse_scalar(cell).type);
+    }
+    return checksum;
+  });
+  measure("列: solution.cpp で1セルずつ", cells.size(), [&] {
+    return static_cast<long long>(legacy_parse_column(cells).size());
+  });
+  measure("列: parse::parse_column    ", cells.size(), [&] {
+    parse::Column column = parse::parse_column(cells);
+    std::cout << "  -> " << parse::to_string(column.type) << std::endl;
+    return static_cast<long long>(column.size());
+  });
+}
+
+void benchmark_example() {
+  constexpr size_t kCells = 1000000;
+  std::cout << "=== ベンチマーク（" << kCells << " セル）===" << std::endl;
+
+  benchmark_column("[整数の列]", make_cells(kCells, 0, false, 1));
+  benchmark_column("[小数の列]", make_cells(kCells, 0, true, 2));
+  benchmark_column("[文字列 90% の列]", make_cells(kCells, 90, false, 3));
+
+  // 下読みだけの比較（数値でないセルをどれだけ早く弾けるか）
+  std::vector<std::string> mixed = make_cells(kCells, 50, true, 4);
+  std::cout << "[下読みのみ（文字列 50%）]" << std::endl;
+  measure("スカラー（分類表）         ", mixed.size(), [&] {
+    long long numeric = 0;
+    for (const auto& cell : mixed) {
+      numeric += parse::detail::scan_chars_scalar(cell.data(), cell.size()).numeric;
+    }
+    return numeric;
+  });
+  measure("scan_chars（SSE2）         ", mixed.size(), [&] {
+    long long numeric = 0;
+    for (const auto& cell : mixed) {
+      numeric += parse::detail::scan_chars(cell.data(), cell.size()).numeric;
+    }
+    return numeric;
+  });
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "例外を使わない parse_value と列の型推論のサンプル\n" << std::endl;
+
+  basic_example();
+  verify_example();
+  benchmark_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
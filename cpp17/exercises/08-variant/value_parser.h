@@ -0,0 +1,353 @@
+// 例外を使わない parse_value と、列ごとの型推論
+// solution.cpp の parse_value は std::stoi → std::stod を try/catch で試すので、
+// 数値でない文字列1つにつき例外が最大2回飛ぶ。文字列の多いデータでは
+// 取り込みの大半が例外処理になる。ここでは
+//   - まず数値に使える文字（0-9 + - . e E）だけかを SSE2 で16バイトずつ調べ、
+//     それ以外の文字を含めば from_chars を呼ばずに文字列と決める
+//   - '.' も指数もなければ整数、あれば浮動小数点として std::from_chars で1回だけ読む
+//   - 列（セルの並び）全体で一番狭い型（int32 < int64 < double < 文字列）を
+//     1パスで決め、型つきの配列に読み込む
+// とする。
+//
+// 受け付ける書式は solution.cpp とほぼ同じだが、次は文字列として扱う:
+//   - 前後の空白（" 42"）
+//   - inf / nan / 16進（0x1A）
+// 先頭の '+' は1つだけ許す。範囲外の浮動小数点（1e999 など）は従来どおり文字列。
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define VALUE_PARSER_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace parse {
+
+// solution.cpp と同じ結果の型
+struct IntValue {
+  int value;
+};
+
+struct FloatValue {
+  double value;
+};
+
+struct StringValue {
+  std::string value;
+};
+
+struct ParseError {
+  std::string error_message;
+};
+
+using ParseResult = std::variant<IntValue, FloatValue, StringValue, ParseError>;
+
+// 値の型。列の型は各セルの型の最大値（狭い順に並べてある）
+enum class ValueType : uint8_t { kEmpty, kInt32, kInt64, kDouble, kString };
+
+inline const char* to_string(ValueType type) {
+  switch (type) {
+    case ValueType::kEmpty:
+      return "empty";
+    case ValueType::kInt32:
+      return "int32";
+    case ValueType::kInt64:
+      return "int64";
+    case ValueType::kDouble:
+      return "double";
+    case ValueType::kString:
+      return "string";
+  }
+  return "?";
+}
+
+namespace detail {
+
+// 文字の下読みの結果
+struct CharScan {
+  bool numeric;   // 数値に使える文字だけか
+  bool fraction;  // '.' か指数（e/E）を含むか
+};
+
+// 1バイトごとの分類表（bit0: 数値に使える, bit1: '.' か e/E）
+struct CharTable {
+  uint8_t flags[256] = {};
+
+  constexpr CharTable() {
+    for (char c = '0'; c <= '9'; ++c) {
+      flags[static_cast<uint8_t>(c)] = 1;
+    }
+    flags[static_cast<uint8_t>('+')] = 1;
+    flags[static_cast<uint8_t>('-')] = 1;
+    flags[static_cast<uint8_t>('.')] = 3;
+    flags[static_cast<uint8_t>('e')] = 3;
+    flags[static_cast<uint8_t>('E')] = 3;
+  }
+};
+
+inline constexpr CharTable kCharTable{};
+
+inline CharScan scan_chars_scalar(const char* data, size_t size) {
+  uint8_t all = 1;
+  uint8_t any = 0;
+  for (size_t i = 0; i < size; ++i) {
+    uint8_t flags = kCharTable.flags[static_cast<uint8_t>(data[i])];
+    all &= flags;
+    any |= flags;
+  }
+  return {all != 0, (any & 2) != 0};
+}
+
+#if defined(VALUE_PARSER_HAS_SSE2)
+
+// SSE2 版。16バイトずつ比較し、最後の半端なブロックも同じページ内に収まるなら
+// そのまま16バイト読んで範囲外のレーンを捨てる（ページをまたぐときだけスカラー）。
+// 範囲外を読むことがあるので AddressSanitizer の検査からは外す
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((no_sanitize_address))
+#endif
+inline CharScan scan_chars(const char* data, size_t size) {
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i plus = _mm_set1_epi8('+');
+  const __m128i minus = _mm_set1_epi8('-');
+  const __m128i dot = _mm_set1_epi8('.');
+  const __m128i lower = _mm_set1_epi8(0x20);
+  const __m128i exponent = _mm_set1_epi8('e');
+
+  unsigned fraction = 0;
+  size_t i = 0;
+  while (i < size) {
+    size_t remaining = size - i;
+    unsigned lanes = 0xFFFF;
+    if (remaining < 16) {
+      uintptr_t address = reinterpret_cast<uintptr_t>(data + i);
+      if ((address & 4095) > 4096 - 16) {
+        CharScan tail = scan_chars_scalar(data + i, remaining);
+        return {tail.numeric, tail.numeric && (fraction != 0 || tail.fraction)};
+      }
+      lanes = (1u << remaining) - 1;
+    }
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i offset = _mm_sub_epi8(bytes, zero);
+    __m128i digit = _mm_cmpeq_epi8(_mm_min_epu8(offset, nine), offset);
+    __m128i sign = _mm_or_si128(_mm_cmpeq_epi8(bytes, plus),
+                                _mm_cmpeq_epi8(bytes, minus));
+    __m128i point = _mm_or_si128(
+        _mm_cmpeq_epi8(bytes, dot),
+        _mm_cmpeq_epi8(_mm_or_si128(bytes, lower), exponent));
+    unsigned ok = static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_or_si128(_mm_or_si128(digit, sign), point)));
+    if ((ok & lanes) != lanes) {
+      return {false, false};
+    }
+    fraction |= static_cast<unsigned>(_mm_movemask_epi8(point)) & lanes;
+    i += 16;
+  }
+  return {true, fraction != 0};
+}
+
+#else
+
+inline CharScan scan_chars(const char* data, size_t size) {
+  return scan_chars_scalar(data, size);
+}
+
+#endif
+
+}  // namespace detail
+
+// 1つの値を読んだ結果。type に応じて integer か real のどちらかが有効
+struct Scalar {
+  ValueType type = ValueType::kEmpty;
+  int64_t integer = 0;
+  double real = 0;
+};
+
+// 例外もヒープ確保もなしに、text の型を決めて読む
+inline Scalar parse_scalar(std::string_view text) {
+  Scalar result;
+  if (text.empty()) {
+    return result;
+  }
+  result.type = ValueType::kString;
+
+  // from_chars は '+' を受け付けないので1つだけ外す（"+-1" は文字列のまま）
+  std::string_view body = text;
+  if (body[0] == '+' && body.size() > 1 && body[1] != '+' && body[1] != '-') {
+    body.remove_prefix(1);
+  }
+  detail::CharScan scan = detail::scan_chars(body.data(), body.size());
+  if (!scan.numeric) {
+    return result;
+  }
+  const char* first = body.data();
+  const char* last = first + body.size();
+
+  if (!scan.fraction) {
+    int64_t value = 0;
+    auto [end, error] = std::from_chars(first, last, value);
+    if (error == std::errc{} && end == last) {
+      result.integer = value;
+      result.type = value >= std::numeric_limits<int32_t>::min() &&
+                            value <= std::numeric_limits<int32_t>::max()
+                        ? ValueType::kInt32
+                        : ValueType::kInt64;
+      return result;
+    }
+    if (error != std::errc::result_out_of_range) {
+      return result;  // "1-2" や "--1" など
+    }
+    // int64 に収まらない整数は浮動小数点として読む
+  }
+
+  double value = 0;
+  auto [end, error] = std::from_chars(first, last, value);
+  if (error == std::errc{} && end == last) {
+    result.real = value;
+    result.type = ValueType::kDouble;
+  }
+  return result;
+}
+
+// solution.cpp の parse_value と同じ結果を、例外なしで返す
+inline ParseResult parse_value(std::string_view text) {
+  Scalar scalar = parse_scalar(text);
+  switch (scalar.type) {
+    case ValueType::kEmpty:
+      return ParseError{"Empty string"};
+    case ValueType::kInt32:
+      return IntValue{static_cast<int>(scalar.integer)};
+    case ValueType::kInt64:
+      // int に収まらない整数は従来どおり double になる
+      return FloatValue{static_cast<double>(scalar.integer)};
+    case ValueType::kDouble:
+      return FloatValue{scalar.real};
+    case ValueType::kString:
+      break;
+  }
+  return StringValue{std::string(text)};
+}
+
+// ============================================================================
+// 列単位の読み込み
+// ============================================================================
+
+// 型つきの列。文字列の列は入力のセルを指す string_view（入力が生きている間だけ有効）
+struct Column {
+  ValueType type = ValueType::kEmpty;
+  std::variant<std::monostate, std::vector<int32_t>, std::vector<int64_t>,
+               std::vector<double>, std::vector<std::string_view>>
+      values;
+  // 空のセルは 0 で、値は 0（文字列なら空）。空のセルがなければ valid 自体が空
+  std::vector<uint8_t> valid;
+
+  size_t size() const {
+    return std::visit(
+        [](const auto& array) -> size_t {
+          if constexpr (std::is_same_v<std::decay_t<decltype(array)>,
+                                       std::monostate>) {
+            return 0;
+          } else {
+            return array.size();
+          }
+        },
+        values);
+  }
+
+  bool is_valid(size_t row) const { return valid.empty() || valid[row] != 0; }
+};
+
+// cells（string_view に変換できる要素の並び）の型を推論して読み込む。
+// 整数のうちは int64 で読み、浮動小数点が来たらそこまでを double に直し、
+// 文字列が来たら残りは読まずに文字列の列にする（どのセルも1回しか読まない）
+template <typename Cells>
+Column parse_column(const Cells& cells) {
+  Column column;
+  size_t count = static_cast<size_t>(std::size(cells));
+  std::vector<int64_t> integers;
+  std::vector<double> reals;
+  ValueType type = ValueType::kEmpty;
+  size_t row = 0;
+
+  for (const auto& cell : cells) {
+    std::string_view text(cell);
+    Scalar scalar = parse_scalar(text);
+    if (scalar.type == ValueType::kString) {
+      type = ValueType::kString;
+      break;
+    }
+    if (scalar.type == ValueType::kEmpty && column.valid.empty()) {
+      column.valid.assign(count, 1);
+    }
+    if (scalar.type == ValueType::kEmpty) {
+      column.valid[row] = 0;
+    }
+    if (scalar.type == ValueType::kDouble && type < ValueType::kDouble) {
+      reals.reserve(count);
+      reals.assign(integers.begin(), integers.end());
+      integers = {};
+    }
+    type = std::max(type, scalar.type);
+    if (type == ValueType::kDouble) {
+      reals.push_back(scalar.type == ValueType::kDouble
+                          ? scalar.real
+                          : static_cast<double>(scalar.integer));
+    } else {
+      if (integers.empty()) {
+        integers.reserve(count);
+      }
+      integers.push_back(scalar.integer);
+    }
+    ++row;
+  }
+
+  column.type = type;
+  switch (type) {
+    case ValueType::kEmpty:  // 空のセルだけなら int32 の 0 を並べる
+      column.values = std::vector<int32_t>(count, 0);
+      break;
+    case ValueType::kInt32:
+      column.values =
+          std::vector<int32_t>(integers.begin(), integers.end());
+      break;
+    case ValueType::kInt64:
+      column.values = std::move(integers);
+      break;
+    case ValueType::kDouble:
+      column.values = std::move(reals);
+      break;
+    case ValueType::kString: {
+      std::vector<std::string_view> strings;
+      strings.reserve(count);
+      column.valid.clear();
+      for (const auto& cell : cells) {
+        strings.emplace_back(cell);
+        if (strings.back().empty()) {
+          if (column.valid.empty()) {
+            column.valid.assign(count, 1);
+          }
+          column.valid[strings.size() - 1] = 0;
+        }
+      }
+      column.values = std::move(strings);
+      break;
+    }
+  }
+  return column;
+}
+
+}  // namespace parse
@@ -0,0 +1,144 @@
+// 任意精度のフィボナッチ数列ジェネレータ
+// example.cpp の fibonacci() は Generator<int> なので、47 項目
+// (F(47) = 2971215073) で int が桁あふれする。
+// ここでは libs/common の BigUint を co_yield し、さらに高速倍加法で
+// 任意の位置 n から数列を開始できるようにする。
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "common/big_uint.h"
+#include "common/fibonacci.h"
+
+using common::BigUint;
+
+// ============================================================================
+// Generator実装（example.cpp と同じもの）
+// ============================================================================
+
+template <typename T>
+struct Generator {
+  struct promise_type {
+    T current_value;
+
+    Generator get_return_object() {
+      return Generator{
+          std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    std::suspend_always yield_value(T value) {
+      current_value = std::move(value);
+      return {};
+    }
+
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+
+  explicit Generator(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+  ~Generator() {
+    if (handle) handle.destroy();
+  }
+
+  Generator(const Generator&) = delete;
+  Generator& operator=(const Generator&) = delete;
+
+  Generator(Generator&& other) noexcept : handle(other.handle) {
+    other.handle = nullptr;
+  }
+
+  struct iterator {
+    std::coroutine_handle<promise_type> handle;
+
+    iterator& operator++() {
+      handle.resume();
+      return *this;
+    }
+
+    // BigUint はコピーが重いので参照で返す
+    const T& operator*() const { return handle.promise().current_value; }
+
+    bool operator==(std::default_sentinel_t) const { return handle.done(); }
+  };
+
+  iterator begin() {
+    handle.resume();
+    return {handle};
+  }
+
+  std::default_sentinel_t end() { return {}; }
+};
+
+// ============================================================================
+// 1. 桁あふれしないフィボナッチ数列
+// ============================================================================
+
+// F(start), F(start + 1), ... を生成する。
+// 開始位置は高速倍加法で O(log start) 回の乗算で求め、
+// 以降は1項につき加算1回で進む。
+Generator<BigUint> fibonacci(uint64_t start = 0) {
+  auto [a, b] = common::fibonacci_pair(start);
+  while (true) {
+    co_yield a;
+    BigUint next = a + b;
+    a = std::move(b);
+    b = std::move(next);
+  }
+}
+
+void overflow_free_example() {
+  std::cout << "=== int の限界を超える ===" << std::endl;
+
+  uint64_t n = 0;
+  for (const BigUint& fib : fibonacci()) {
+    if (n >= 44 && n <= 50) {
+      std::cout << "F(" << n << ") = " << fib.to_string()
+                << (n >= 47 ? "  (int では桁あふれ)" : "") << std::endl;
+    }
+    if (++n > 50) break;
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. 任意の位置から開始する
+// ============================================================================
+
+void jump_start_example() {
+  std::cout << "=== F(1000) から開始 ===" << std::endl;
+
+  uint64_t n = 1000;
+  for (const BigUint& fib : fibonacci(1000)) {
+    std::string digits = fib.to_string();
+    std::cout << "F(" << n << ") = " << digits.substr(0, 12) << "... ("
+              << digits.size() << " 桁)" << std::endl;
+    if (++n >= 1003) break;
+  }
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "任意精度フィボナッチジェネレータのサンプル\n" << std::endl;
+
+  overflow_free_example();
+  jump_start_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
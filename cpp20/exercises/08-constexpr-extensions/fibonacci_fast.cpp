@@ -0,0 +1,83 @@
+// コンパイル時フィボナッチ（O(log n) 版）
+// example.cpp の fibonacci_consteval は指数時間の再帰なので、n が 30 を
+// 超えたあたりからコンパイル時評価のステップ数上限に引っかかる。
+// libs/common の fibonacci_u64 は高速倍加法で 7 回のループしか回らないため、
+// uint64_t に収まる上限 F(93) までコンパイル時に計算できる。
+// さらに大きな n は実行時に BigUint 版を使う。
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "common/big_uint.h"
+#include "common/fibonacci.h"
+
+// ============================================================================
+// 1. consteval での利用
+// ============================================================================
+
+consteval uint64_t fibonacci_consteval(uint64_t n) {
+  return common::fibonacci_u64(n);  // n > 93 はコンパイルエラーになる
+}
+
+static_assert(fibonacci_consteval(10) == 55);
+static_assert(fibonacci_consteval(50) == 12586269025ull);
+static_assert(fibonacci_consteval(93) == 12200160415121876738ull);
+
+// コンパイル時に全テーブルを作る
+consteval std::array<uint64_t, common::kMaxFibonacciU64 + 1>
+make_fibonacci_table() {
+  std::array<uint64_t, common::kMaxFibonacciU64 + 1> table{};
+  for (uint64_t i = 0; i < table.size(); ++i) {
+    table[i] = common::fibonacci_u64(i);
+  }
+  return table;
+}
+
+constexpr auto kFibonacciTable = make_fibonacci_table();
+
+void consteval_example() {
+  std::cout << "=== コンパイル時フィボナッチ ===" << std::endl;
+
+  constexpr uint64_t fib80 = fibonacci_consteval(80);
+  std::cout << "fibonacci_consteval(80): " << fib80 << std::endl;
+  std::cout << "テーブルの最後の要素 F(" << kFibonacciTable.size() - 1
+            << "): " << kFibonacciTable.back() << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// 2. constexpr 関数を実行時にも使う
+// ============================================================================
+
+void runtime_example() {
+  std::cout << "=== 実行時の利用 ===" << std::endl;
+
+  // constexpr 関数は実行時の値でも呼べる
+  uint64_t n = 60;
+  std::cout << "fibonacci_u64(" << n << ") at runtime: "
+            << common::fibonacci_u64(n) << std::endl;
+
+  // uint64_t を超える範囲は BigUint 版へ
+  n = 200;
+  std::cout << "fibonacci(" << n << ") = " << common::fibonacci(n).to_string()
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// ============================================================================
+// メイン関数
+// ============================================================================
+
+int main() {
+  std::cout << "O(log n) コンパイル時フィボナッチのサンプル\n" << std::endl;
+
+  consteval_example();
+  runtime_example();
+
+  std::cout << "全てのサンプルが完了しました！" << std::endl;
+  return 0;
+}
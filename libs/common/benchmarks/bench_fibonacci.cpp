@@ -0,0 +1,102 @@
+// フィボナッチ計算のベンチマーク
+//   - F(10^6) を高速倍加法で計算（Karatsuba あり / 筆算のみ）
+//   - 逐次加算との比較（n = 10^5）
+//   - 下位 9 桁を mod 10^9 の逐次計算と照合して検証する
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#include "common/big_uint.h"
+#include "common/fibonacci.h"
+
+using common::BigUint;
+
+namespace {
+
+template <typename Func>
+double measure_ms(Func&& func) {
+  auto begin = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  return elapsed.count();
+}
+
+uint32_t fibonacci_mod(uint64_t n, uint32_t modulus) {
+  uint64_t a = 0;
+  uint64_t b = 1;
+  for (uint64_t i = 0; i < n; ++i) {
+    uint64_t next = (a + b) % modulus;
+    a = b;
+    b = next;
+  }
+  return static_cast<uint32_t>(a);
+}
+
+BigUint fibonacci_linear(uint64_t n) {
+  BigUint a(0);
+  BigUint b(1);
+  for (uint64_t i = 0; i < n; ++i) {
+    BigUint next = a + b;
+    a = std::move(b);
+    b = std::move(next);
+  }
+  return a;
+}
+
+void report(const char* label, uint64_t n, const BigUint& value, double ms) {
+  constexpr uint32_t kModulus = 1000000000u;
+  bool ok = value.mod(kModulus) == fibonacci_mod(n, kModulus);
+  auto digits = static_cast<uint64_t>(
+      std::floor(static_cast<double>(value.bit_length() - 1) * std::log10(2.0)) +
+      1);
+  std::cout << std::left << std::setw(28) << label << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2) << ms
+            << " ms  (約 " << digits << " 桁, 下位9桁 "
+            << std::setw(9) << std::setfill('0') << value.mod(kModulus)
+            << std::setfill(' ') << (ok ? " OK" : " NG") << ")" << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  std::cout << "=== フィボナッチ数のベンチマーク ===" << std::endl;
+
+  // constexpr 版はコンパイル時に評価できる
+  static_assert(common::fibonacci_u64(10) == 55);
+  static_assert(common::fibonacci_u64(93) == 12200160415121876738ull);
+
+  constexpr uint64_t kLarge = 1000000;
+  BigUint karatsuba;
+  double karatsuba_ms =
+      measure_ms([&] { karatsuba = common::fibonacci(kLarge); });
+  report("fast doubling + Karatsuba", kLarge, karatsuba, karatsuba_ms);
+
+  BigUint schoolbook;
+  double schoolbook_ms = measure_ms([&] {
+    schoolbook =
+        common::fibonacci(kLarge, std::numeric_limits<size_t>::max());
+  });
+  report("fast doubling (筆算のみ)", kLarge, schoolbook, schoolbook_ms);
+  std::cout << "  結果の一致: " << (karatsuba == schoolbook ? "OK" : "NG")
+            << std::endl;
+
+  constexpr uint64_t kMedium = 100000;
+  BigUint doubling;
+  double doubling_ms = measure_ms([&] { doubling = common::fibonacci(kMedium); });
+  report("fast doubling (n=10^5)", kMedium, doubling, doubling_ms);
+
+  BigUint linear;
+  double linear_ms = measure_ms([&] { linear = fibonacci_linear(kMedium); });
+  report("逐次加算 (n=10^5)", kMedium, linear, linear_ms);
+  std::cout << "  結果の一致: " << (doubling == linear ? "OK" : "NG")
+            << std::endl;
+
+  std::cout << "\nF(100) = " << common::fibonacci(100).to_string()
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,257 @@
+// 任意精度の符号なし整数
+// 32bit リムのリトルエンディアン配列で表現する。乗算はリム数が
+// しきい値を超えると Karatsuba 法（O(n^1.585)）に切り替わる。
+// C++17 以降で使えるヘッダオンリー実装。
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace common {
+
+class BigUint {
+ public:
+  using Limb = uint32_t;
+  using Limbs = std::vector<Limb>;
+
+  // これ未満のリム数では筆算の方が速い（環境によって調整する）
+  static constexpr size_t kKaratsubaThreshold = 48;
+
+  BigUint() = default;
+
+  BigUint(uint64_t value) {  // NOLINT(google-explicit-constructor)
+    while (value != 0) {
+      limbs_.push_back(static_cast<Limb>(value));
+      value >>= 32;
+    }
+  }
+
+  bool is_zero() const { return limbs_.empty(); }
+  size_t limb_count() const { return limbs_.size(); }
+  const Limbs& limbs() const { return limbs_; }
+
+  size_t bit_length() const {
+    if (limbs_.empty()) {
+      return 0;
+    }
+    size_t bits = (limbs_.size() - 1) * 32;
+    for (Limb top = limbs_.back(); top != 0; top >>= 1) {
+      ++bits;
+    }
+    return bits;
+  }
+
+  // 小さな数での剰余（下位桁の検証などに使う）
+  uint32_t mod(uint32_t divisor) const {
+    uint64_t remainder = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) {
+      remainder = ((remainder << 32) | limbs_[i]) % divisor;
+    }
+    return static_cast<uint32_t>(remainder);
+  }
+
+  // 10進文字列（10^9 で繰り返し割るので O(n^2)。表示用）
+  std::string to_string() const {
+    if (limbs_.empty()) {
+      return "0";
+    }
+    Limbs work = limbs_;
+    std::vector<uint32_t> chunks;  // 下位から 9 桁ずつ
+    while (!work.empty()) {
+      uint64_t remainder = 0;
+      for (size_t i = work.size(); i-- > 0;) {
+        uint64_t current = (remainder << 32) | work[i];
+        work[i] = static_cast<Limb>(current / 1000000000u);
+        remainder = current % 1000000000u;
+      }
+      trim(work);
+      chunks.push_back(static_cast<uint32_t>(remainder));
+    }
+    std::string result = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+      std::string part = std::to_string(chunks[i]);
+      result.append(9 - part.size(), '0');
+      result += part;
+    }
+    return result;
+  }
+
+  friend bool operator==(const BigUint& a, const BigUint& b) {
+    return a.limbs_ == b.limbs_;
+  }
+  friend bool operator!=(const BigUint& a, const BigUint& b) {
+    return !(a == b);
+  }
+
+  friend BigUint operator+(const BigUint& a, const BigUint& b) {
+    BigUint result;
+    result.limbs_ = add(a.limbs_, b.limbs_);
+    return result;
+  }
+
+  // a >= b が前提
+  friend BigUint operator-(const BigUint& a, const BigUint& b) {
+    BigUint result(a);
+    subtract_in_place(result.limbs_, b.limbs_);
+    return result;
+  }
+
+  friend BigUint operator*(const BigUint& a, const BigUint& b) {
+    return multiply(a, b, kKaratsubaThreshold);
+  }
+
+  // しきい値を指定した乗算（SIZE_MAX を渡すと常に筆算）
+  static BigUint multiply(const BigUint& a, const BigUint& b,
+                          size_t karatsuba_threshold) {
+    BigUint result;
+    result.limbs_ = multiply_limbs(a.limbs_, b.limbs_,
+                                   std::max<size_t>(karatsuba_threshold, 2));
+    return result;
+  }
+
+ private:
+  static void trim(Limbs& v) {
+    while (!v.empty() && v.back() == 0) {
+      v.pop_back();
+    }
+  }
+
+  static Limbs add(const Limbs& a, const Limbs& b) {
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+    Limbs result(longer.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.size(); ++i) {
+      uint64_t sum = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0);
+      result[i] = static_cast<Limb>(sum);
+      carry = sum >> 32;
+    }
+    result[longer.size()] = static_cast<Limb>(carry);
+    trim(result);
+    return result;
+  }
+
+  // a -= b（a >= b が前提）
+  static void subtract_in_place(Limbs& a, const Limbs& b) {
+    if (b.size() > a.size()) {
+      throw std::underflow_error("BigUint subtraction would be negative");
+    }
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+      int64_t diff = static_cast<int64_t>(a[i]) - borrow -
+                     (i < b.size() ? static_cast<int64_t>(b[i]) : 0);
+      borrow = diff < 0 ? 1 : 0;
+      a[i] = static_cast<Limb>(diff + (borrow << 32));
+      if (borrow == 0 && i >= b.size()) {
+        break;
+      }
+    }
+    if (borrow != 0) {
+      throw std::underflow_error("BigUint subtraction would be negative");
+    }
+    trim(a);
+  }
+
+  // r += x << (32 * offset)
+  static void add_shifted_in_place(Limbs& r, const Limbs& x, size_t offset) {
+    if (r.size() < offset + x.size() + 1) {
+      r.resize(offset + x.size() + 1, 0);
+    }
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < x.size(); ++i) {
+      uint64_t sum = carry + r[offset + i] + x[i];
+      r[offset + i] = static_cast<Limb>(sum);
+      carry = sum >> 32;
+    }
+    for (size_t j = offset + i; carry != 0; ++j) {
+      if (j == r.size()) {
+        r.push_back(0);
+      }
+      uint64_t sum = carry + r[j];
+      r[j] = static_cast<Limb>(sum);
+      carry = sum >> 32;
+    }
+  }
+
+  static Limbs schoolbook(const Limbs& a, const Limbs& b) {
+    Limbs result(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+      uint64_t carry = 0;
+      uint64_t ai = a[i];
+      for (size_t j = 0; j < b.size(); ++j) {
+        uint64_t cur = ai * b[j] + result[i + j] + carry;
+        result[i + j] = static_cast<Limb>(cur);
+        carry = cur >> 32;
+      }
+      result[i + b.size()] = static_cast<Limb>(carry);
+    }
+    trim(result);
+    return result;
+  }
+
+  static Limbs slice(const Limbs& v, size_t begin, size_t end) {
+    begin = std::min(begin, v.size());
+    end = std::min(end, v.size());
+    Limbs result(v.begin() + static_cast<std::ptrdiff_t>(begin),
+                 v.begin() + static_cast<std::ptrdiff_t>(end));
+    trim(result);
+    return result;
+  }
+
+  static Limbs multiply_limbs(const Limbs& a, const Limbs& b,
+                              size_t threshold) {
+    if (a.empty() || b.empty()) {
+      return {};
+    }
+    if (std::min(a.size(), b.size()) < threshold) {
+      return schoolbook(a, b);
+    }
+
+    size_t half = std::max(a.size(), b.size()) / 2;
+    if (std::min(a.size(), b.size()) <= half) {
+      // 大きさが極端に違う場合は長い方だけを分割する
+      const Limbs& longer = a.size() >= b.size() ? a : b;
+      const Limbs& shorter = a.size() >= b.size() ? b : a;
+      Limbs result =
+          multiply_limbs(slice(longer, 0, half), shorter, threshold);
+      add_shifted_in_place(
+          result,
+          multiply_limbs(slice(longer, half, longer.size()), shorter,
+                         threshold),
+          half);
+      trim(result);
+      return result;
+    }
+
+    // a = a1 * B^half + a0, b = b1 * B^half + b0
+    Limbs a0 = slice(a, 0, half);
+    Limbs a1 = slice(a, half, a.size());
+    Limbs b0 = slice(b, 0, half);
+    Limbs b1 = slice(b, half, b.size());
+
+    Limbs z0 = multiply_limbs(a0, b0, threshold);
+    Limbs z2 = multiply_limbs(a1, b1, threshold);
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+    Limbs z1 = multiply_limbs(add(a0, a1), add(b0, b1), threshold);
+    subtract_in_place(z1, z0);
+    subtract_in_place(z1, z2);
+
+    Limbs result(a.size() + b.size() + 1, 0);
+    add_shifted_in_place(result, z0, 0);
+    add_shifted_in_place(result, z1, half);
+    add_shifted_in_place(result, z2, 2 * half);
+    trim(result);
+    return result;
+  }
+
+  Limbs limbs_;  // 上位のゼロリムは持たない
+};
+
+}  // namespace common
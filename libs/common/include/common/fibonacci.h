@@ -0,0 +1,76 @@
+// 高速倍加法（fast doubling）によるフィボナッチ数の計算
+//
+//   F(2k)   = F(k) * (2F(k+1) - F(k))
+//   F(2k+1) = F(k)^2 + F(k+1)^2
+//
+// n のビットを上位から辿るので乗算は O(log n) 回で済む。
+//   - fibonacci_u64: constexpr 版（n <= 93 で uint64_t に収まる）
+//   - fibonacci_pair / fibonacci: BigUint による任意精度版
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "common/big_uint.h"
+
+namespace common {
+
+// uint64_t に収まる最大の n（F(93) = 12200160415121876738）
+inline constexpr uint64_t kMaxFibonacciU64 = 93;
+
+// コンパイル時にも実行時にも使える O(log n) 版
+constexpr uint64_t fibonacci_u64(uint64_t n) {
+  if (n > kMaxFibonacciU64) {
+    throw std::overflow_error("fibonacci_u64: n is too large for uint64_t");
+  }
+  uint64_t a = 0;  // F(k)
+  uint64_t b = 1;  // F(k+1)
+  for (int bit = 6; bit >= 0; --bit) {
+    uint64_t c = a * (2 * b - a);  // F(2k)
+    uint64_t d = a * a + b * b;    // F(2k+1)
+    if ((n >> bit) & 1) {
+      a = d;
+      // n = 93 の最終段では F(94) が折り返すが、戻り値には使わない
+      // （符号なし整数なので未定義動作にはならない）
+      b = c + d;
+    } else {
+      a = c;
+      b = d;
+    }
+  }
+  return a;
+}
+
+// (F(n), F(n+1)) を返す
+inline std::pair<BigUint, BigUint> fibonacci_pair(
+    uint64_t n, size_t karatsuba_threshold = BigUint::kKaratsubaThreshold) {
+  BigUint a(0);  // F(k)
+  BigUint b(1);  // F(k+1)
+  int top = 63;
+  while (top >= 0 && ((n >> top) & 1) == 0) {
+    --top;
+  }
+  for (int bit = top; bit >= 0; --bit) {
+    BigUint two_b_minus_a = (b + b) - a;
+    BigUint c = BigUint::multiply(a, two_b_minus_a, karatsuba_threshold);
+    BigUint d = BigUint::multiply(a, a, karatsuba_threshold) +
+                BigUint::multiply(b, b, karatsuba_threshold);
+    if ((n >> bit) & 1) {
+      b = c + d;
+      a = std::move(d);
+    } else {
+      a = std::move(c);
+      b = std::move(d);
+    }
+  }
+  return {std::move(a), std::move(b)};
+}
+
+inline BigUint fibonacci(
+    uint64_t n, size_t karatsuba_threshold = BigUint::kKaratsubaThreshold) {
+  return fibonacci_pair(n, karatsuba_threshold).first;
+}
+
+}  // namespace common